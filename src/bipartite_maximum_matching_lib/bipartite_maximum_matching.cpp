@@ -1,113 +1,768 @@
 #include "bipartite_maximum_matching.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <cstddef>
-#include <cstdint>
 #include <limits>
-#include <optional>
-#include <queue>
 #include <utility>
 #include <vector>
 
+#include "flow_network.hpp"
+#include "parallel_for.hpp"
+
 /**
  * @brief maximum cardinality matching in bipartite graphs
  */
 namespace bipartite_maximum_matching {
 
-int_fast8_t bfs(std::size_t start, std::vector<std::vector<int_fast8_t>> &graph,
-                std::vector<std::optional<size_t>> &parent, std::size_t end) {
-	std::queue<std::pair<size_t, int_fast8_t>> q;
-	parent.assign(parent.size(), std::nullopt);
-	q.emplace(start, std::numeric_limits<int_fast8_t>::max());
-	int_fast8_t new_flow = 0;
-	while (!q.empty()) {
-		size_t current = q.front().first;
-		const int_fast8_t current_flow = q.front().second;
-		q.pop();
-		for (size_t i = 0; i < graph[current].size(); i++) {
-			if (graph[current][i] > 0 && !parent[i] && i != start) {
-				parent[i] = current;
-				new_flow = std::min(graph[current][i], current_flow);
-				q.emplace(i, new_flow);
-			}
-		}
-	}
-	return parent[end] ? new_flow : 0;
+constexpr std::size_t NIL = std::numeric_limits<std::size_t>::max();
+
+/**
+ * @brief Bipartite graph stored as a compressed sparse row adjacency of the left partition.
+ * @details Neighbours of left vertex u are `targets[offsets[u]] ... targets[offsets[u + 1] - 1]`
+ * in the order in which the edges were given.
+ */
+struct BipartiteGraph {
+	std::size_t left_num = 0;
+	std::size_t right_num = 0;
+	std::vector<std::size_t> offsets;
+	std::vector<std::size_t> targets;
+};
+
+BipartiteGraph build_graph(const std::vector<std::pair<std::size_t, std::size_t>> &pairs) {
+	BipartiteGraph graph;
+	for (const auto &pair : pairs) {
+		graph.left_num = std::max(graph.left_num, pair.first + 1);
+		graph.right_num = std::max(graph.right_num, pair.second + 1);
+	}
+
+	graph.offsets.assign(graph.left_num + 1, 0);
+	for (const auto &pair : pairs) {
+		graph.offsets[pair.first + 1]++;
+	}
+	for (std::size_t i = 0; i < graph.left_num; i++) {
+		graph.offsets[i + 1] += graph.offsets[i];
+	}
+
+	// stable counting sort keeps the input order of edges within every row
+	std::vector<std::size_t> position(graph.offsets.begin(), graph.offsets.end() - 1);
+	graph.targets.resize(pairs.size());
+	for (const auto &pair : pairs) {
+		graph.targets[position[pair.first]++] = pair.second;
+	}
+
+	return graph;
+}
+
+/**
+ * @brief Adds the pairs of a caller supplied matching that are edges of the graph and do not
+ * conflict with already matched vertices.
+ */
+void apply_initial_matching(const BipartiteGraph &graph,
+                            const std::vector<std::pair<std::size_t, std::size_t>> &initial,
+                            std::vector<std::size_t> &match_left,
+                            std::vector<std::size_t> &match_right) {
+	for (const auto &pair : initial) {
+		const std::size_t u = pair.first;
+		const std::size_t v = pair.second;
+		if (u >= graph.left_num || v >= graph.right_num) continue;
+		if (match_left[u] != NIL || match_right[v] != NIL) continue;
+
+		const auto begin = graph.targets.begin() + static_cast<std::ptrdiff_t>(graph.offsets[u]);
+		const auto end = graph.targets.begin() + static_cast<std::ptrdiff_t>(graph.offsets[u + 1]);
+		if (std::find(begin, end, v) != end) {
+			match_left[u] = v;
+			match_right[v] = u;
+		}
+	}
+}
+
+/**
+ * @brief Karp-Sipser degree-1 reduction.
+ * @details A free vertex with exactly one free neighbour can always be matched with it without
+ * losing optimality. Matching it removes both vertices, which may create new degree-1 vertices,
+ * so they are processed with a queue in O(V + E).
+ */
+void karp_sipser(const BipartiteGraph &graph, std::vector<std::size_t> &match_left,
+                 std::vector<std::size_t> &match_right) {
+	const std::size_t left_num = graph.left_num;
+
+	// reverse adjacency of the right partition
+	std::vector<std::size_t> right_offsets(graph.right_num + 1, 0);
+	for (const std::size_t v : graph.targets) {
+		right_offsets[v + 1]++;
+	}
+	for (std::size_t v = 0; v < graph.right_num; v++) {
+		right_offsets[v + 1] += right_offsets[v];
+	}
+	std::vector<std::size_t> right_sources(graph.targets.size());
+	std::vector<std::size_t> position(right_offsets.begin(), right_offsets.end() - 1);
+	for (std::size_t u = 0; u < left_num; u++) {
+		for (std::size_t e = graph.offsets[u]; e < graph.offsets[u + 1]; e++) {
+			right_sources[position[graph.targets[e]]++] = u;
+		}
+	}
+
+	// vertices are numbered 0..left_num-1 for the left and left_num.. for the right partition
+	const auto is_free = [&](std::size_t x) {
+		return x < left_num ? match_left[x] == NIL : match_right[x - left_num] == NIL;
+	};
+	const auto neighbours = [&](std::size_t x) {
+		return x < left_num
+		           ? std::make_pair(graph.targets.data() + graph.offsets[x],
+		                            graph.targets.data() + graph.offsets[x + 1])
+		           : std::make_pair(right_sources.data() + right_offsets[x - left_num],
+		                            right_sources.data() + right_offsets[x - left_num + 1]);
+	};
+	const auto other_side = [&](std::size_t x, std::size_t y) {
+		return x < left_num ? y + left_num : y;
+	};
+
+	std::vector<std::size_t> degree(left_num + graph.right_num, 0);
+	std::vector<std::size_t> queue;
+	for (std::size_t x = 0; x < degree.size(); x++) {
+		if (!is_free(x)) continue;
+		const auto range = neighbours(x);
+		for (const std::size_t *it = range.first; it != range.second; it++) {
+			if (is_free(other_side(x, *it))) degree[x]++;
+		}
+		if (degree[x] == 1) queue.push_back(x);
+	}
+
+	for (std::size_t head = 0; head < queue.size(); head++) {
+		const std::size_t x = queue[head];
+		if (!is_free(x) || degree[x] == 0) continue;
+
+		const auto range = neighbours(x);
+		const std::size_t *mate = std::find_if(range.first, range.second, [&](std::size_t y) {
+			return is_free(other_side(x, y));
+		});
+		const std::size_t y = other_side(x, *mate);
+
+		const std::size_t u = std::min(x, y);
+		const std::size_t v = std::max(x, y) - left_num;
+		match_left[u] = v;
+		match_right[v] = u;
+
+		const auto removed = neighbours(y);
+		for (const std::size_t *it = removed.first; it != removed.second; it++) {
+			const std::size_t z = other_side(y, *it);
+			if (!is_free(z)) continue;
+			if (--degree[z] == 1) queue.push_back(z);
+		}
+	}
+}
+
+/**
+ * @brief Matches every free left vertex with its first free neighbour.
+ */
+void greedy_matching(const BipartiteGraph &graph, std::vector<std::size_t> &match_left,
+                     std::vector<std::size_t> &match_right) {
+	for (std::size_t u = 0; u < graph.left_num; u++) {
+		if (match_left[u] != NIL) continue;
+		for (std::size_t e = graph.offsets[u]; e < graph.offsets[u + 1]; e++) {
+			const std::size_t v = graph.targets[e];
+			if (match_right[v] == NIL) {
+				match_left[u] = v;
+				match_right[v] = u;
+				break;
+			}
+		}
+	}
 }
 
-std::vector<std::vector<int_fast8_t>>
-maxflow(size_t source, std::vector<std::vector<int_fast8_t>> network, size_t sink) {
-	std::vector<std::optional<size_t>> parent(network.size());
-	auto flow = std::vector<std::vector<int_fast8_t>>(network.size(),
-	                                                  std::vector<int_fast8_t>(network[0].size()));
+/**
+ * @brief Per-vertex scratch arrays of the augmenting path searches.
+ * @details Parts of the graph without common vertices only touch their own entries, so they can
+ * be solved concurrently with one workspace.
+ */
+struct SearchWorkspace {
+	std::vector<std::size_t> dist;
+	std::vector<std::size_t> current_arc;
+
+	explicit SearchWorkspace(const BipartiteGraph &graph)
+	    : dist(graph.left_num), current_arc(graph.left_num) {}
+};
+
+/**
+ * @brief State of the Hopcroft-Karp algorithm.
+ * @details `match_left[u]` is the right vertex matched with left vertex u (or NIL) and
+ * `match_right[v]` is the left vertex matched with right vertex v (or NIL). The search is limited
+ * to the given left vertices, which must be closed under the alternating paths (e.g. a union of
+ * connected components).
+ */
+class HopcroftKarp {
+	const BipartiteGraph &graph;
+	std::vector<std::size_t> &match_left;
+	std::vector<std::size_t> &match_right;
+	const std::size_t *lefts_begin;
+	const std::size_t *lefts_end;
+
+	std::vector<std::size_t> &dist;
+	std::vector<std::size_t> &current_arc;
+	std::vector<std::size_t> queue;
+	std::vector<std::size_t> stack;
+
+	/**
+	 * @brief length of the shortest augmenting path found by the last call to layer()
+	 */
+	std::size_t limit = NIL;
+
+	/**
+	 * @brief Builds BFS layers of alternating paths starting from all free left vertices.
+	 * @returns true if there is at least one augmenting path.
+	 */
+	bool layer() {
+		queue.clear();
+		for (const std::size_t *it = lefts_begin; it != lefts_end; it++) {
+			if (match_left[*it] == NIL) {
+				dist[*it] = 0;
+				queue.push_back(*it);
+			} else {
+				dist[*it] = NIL;
+			}
+		}
+
+		limit = NIL;
+		for (std::size_t head = 0; head < queue.size(); head++) {
+			const std::size_t u = queue[head];
+			if (dist[u] >= limit) continue;
+
+			for (std::size_t e = graph.offsets[u]; e < graph.offsets[u + 1]; e++) {
+				const std::size_t w = match_right[graph.targets[e]];
+				if (w == NIL) {
+					limit = std::min(limit, dist[u] + 1);
+				} else if (dist[w] == NIL) {
+					dist[w] = dist[u] + 1;
+					queue.push_back(w);
+				}
+			}
+		}
+
+		return limit != NIL;
+	}
+
+	/**
+	 * @brief Searches for a shortest augmenting path from a free left vertex along the layers and
+	 * applies it to the matching.
+	 * @details Iterative DFS with current-arc pointers, so that every edge is scanned at most once
+	 * per phase and long paths do not exhaust the call stack.
+	 * @returns true if the matching has been augmented.
+	 */
+	bool augment(std::size_t root) {
+		stack.assign(1, root);
+		while (!stack.empty()) {
+			const std::size_t u = stack.back();
+			std::size_t &arc = current_arc[u];
 
-	int_fast8_t new_flow = 0;
-	while ((new_flow = bfs(source, network, parent, sink)) > 0) {
-		size_t current = sink;
-		while (current != source) {
-			const size_t current_parent =
-			    parent[current].value(); // NOLINT(bugprone-unchecked-optional-access)
-			                             // zakładamy, że bfs działa poprawnie
-			network[current_parent][current] -= new_flow;
-			network[current][current_parent] += new_flow;
+			if (arc == graph.offsets[u + 1]) {
+				dist[u] = NIL;
+				stack.pop_back();
+				if (!stack.empty()) current_arc[stack.back()]++;
+				continue;
+			}
 
-			flow[current_parent][current] += new_flow;
-			flow[current][current_parent] -= new_flow;
+			const std::size_t w = match_right[graph.targets[arc]];
+			if (w == NIL && dist[u] + 1 == limit) {
+				for (const std::size_t left : stack) {
+					const std::size_t right = graph.targets[current_arc[left]];
+					match_left[left] = right;
+					match_right[right] = left;
+				}
+				return true;
+			}
 
-			current = current_parent;
+			if (w != NIL && dist[w] == dist[u] + 1) {
+				stack.push_back(w);
+			} else {
+				arc++;
+			}
 		}
+		return false;
 	}
 
-	return flow;
+  public:
+	HopcroftKarp(const BipartiteGraph &graph, std::vector<std::size_t> &match_left,
+	             std::vector<std::size_t> &match_right, SearchWorkspace &workspace,
+	             const std::size_t *lefts_begin, const std::size_t *lefts_end)
+	    : graph(graph), match_left(match_left), match_right(match_right), lefts_begin(lefts_begin),
+	      lefts_end(lefts_end), dist(workspace.dist), current_arc(workspace.current_arc) {}
+
+	/**
+	 * @brief Extends the current matching to a maximum one in O(E sqrt(V)).
+	 */
+	void run() {
+		while (layer()) {
+			for (const std::size_t *it = lefts_begin; it != lefts_end; it++) {
+				current_arc[*it] = graph.offsets[*it];
+			}
+			for (const std::size_t *it = lefts_begin; it != lefts_end; it++) {
+				if (match_left[*it] == NIL) augment(*it);
+			}
+		}
+	}
+};
+
+/**
+ * @brief Runs the sequential Hopcroft-Karp algorithm on the whole graph.
+ */
+void hopcroft_karp(const BipartiteGraph &graph, std::vector<std::size_t> &match_left,
+                   std::vector<std::size_t> &match_right) {
+	SearchWorkspace workspace(graph);
+	std::vector<std::size_t> lefts(graph.left_num);
+	for (std::size_t u = 0; u < graph.left_num; u++) {
+		lefts[u] = u;
+	}
+	HopcroftKarp(graph, match_left, match_right, workspace, lefts.data(),
+	             lefts.data() + lefts.size())
+	    .run();
+}
+
+/**
+ * @brief Hopcroft-Karp algorithm with every phase split between threads.
+ * @details BFS layers are built level by level with the frontier divided between threads, a
+ * vertex joins the next level by a compare-and-swap on its distance. Augmenting paths are then
+ * searched concurrently from different free vertices. Every left vertex and every free right
+ * vertex is claimed with an atomic stamp before it is used, so the paths found in one phase are
+ * vertex-disjoint and are applied without locks. If contention prevents all augmentations in a
+ * phase, the remaining work is finished by the sequential algorithm, so the matching is always
+ * maximum.
+ */
+class ParallelHopcroftKarp {
+	static constexpr std::size_t BFS_GRAIN = 1024;
+	static constexpr std::size_t DFS_GRAIN = 64;
+
+	const BipartiteGraph &graph;
+	std::vector<std::size_t> &result_left;
+	std::vector<std::size_t> &result_right;
+	std::size_t threads;
+
+	std::vector<std::atomic<std::size_t>> match_left;
+	std::vector<std::atomic<std::size_t>> match_right;
+	std::vector<std::atomic<std::size_t>> dist;
+
+	/**
+	 * @brief number of the phase in which a vertex was claimed by an augmenting path search
+	 */
+	std::vector<std::atomic<std::size_t>> left_claim;
+	std::vector<std::atomic<std::size_t>> right_claim;
+	std::size_t phase = 0;
+
+	/**
+	 * @brief current arc of every left vertex, only accessed by the thread that claimed it
+	 */
+	std::vector<std::size_t> current_arc;
+	std::vector<std::size_t> roots;
+	std::vector<std::size_t> frontier;
+	std::vector<std::vector<std::size_t>> next_frontier;
+	std::vector<std::vector<std::size_t>> stacks;
+
+	std::size_t limit = NIL;
+
+	bool claim(std::atomic<std::size_t> &stamp) const {
+		std::size_t old = stamp.load(std::memory_order_relaxed);
+		return old != phase && stamp.compare_exchange_strong(old, phase, std::memory_order_acq_rel);
+	}
+
+	bool layer() {
+		roots.clear();
+		for (std::size_t u = 0; u < graph.left_num; u++) {
+			if (match_left[u].load(std::memory_order_relaxed) == NIL) {
+				dist[u].store(0, std::memory_order_relaxed);
+				roots.push_back(u);
+			} else {
+				dist[u].store(NIL, std::memory_order_relaxed);
+			}
+		}
+
+		std::size_t level = 0;
+		std::atomic<std::size_t> found{NIL};
+		const auto expand = [&](std::size_t begin, std::size_t end, std::size_t thread) {
+			for (std::size_t i = begin; i < end; i++) {
+				const std::size_t u = frontier[i];
+				for (std::size_t e = graph.offsets[u]; e < graph.offsets[u + 1]; e++) {
+					const std::size_t v = graph.targets[e];
+					const std::size_t w = match_right[v].load(std::memory_order_relaxed);
+					std::size_t unvisited = NIL;
+					if (w == NIL) {
+						found.store(level + 1, std::memory_order_relaxed);
+					} else if (dist[w].compare_exchange_strong(unvisited, level + 1,
+					                                           std::memory_order_relaxed)) {
+						next_frontier[thread].push_back(w);
+					}
+				}
+			}
+		};
+
+		frontier = roots;
+		for (; !frontier.empty() && found.load() == NIL; level++) {
+			parallel_for(threads, frontier.size(), BFS_GRAIN, expand);
+			frontier.clear();
+			for (auto &part : next_frontier) {
+				frontier.insert(frontier.end(), part.begin(), part.end());
+				part.clear();
+			}
+		}
+
+		limit = found.load();
+		return limit != NIL;
+	}
+
+	bool augment(std::size_t root, std::vector<std::size_t> &stack) {
+		if (!claim(left_claim[root])) return false;
+
+		stack.assign(1, root);
+		while (!stack.empty()) {
+			const std::size_t u = stack.back();
+			std::size_t &arc = current_arc[u];
+
+			if (arc == graph.offsets[u + 1]) {
+				dist[u].store(NIL, std::memory_order_relaxed);
+				stack.pop_back();
+				if (!stack.empty()) current_arc[stack.back()]++;
+				continue;
+			}
+
+			const std::size_t v = graph.targets[arc];
+			const std::size_t w = match_right[v].load(std::memory_order_relaxed);
+			const std::size_t next_dist = dist[u].load(std::memory_order_relaxed) + 1;
+
+			if (w == NIL) {
+				if (next_dist == limit && claim(right_claim[v])) {
+					for (const std::size_t left : stack) {
+						const std::size_t right = graph.targets[current_arc[left]];
+						match_left[left].store(right, std::memory_order_relaxed);
+						match_right[right].store(left, std::memory_order_relaxed);
+					}
+					return true;
+				}
+			} else if (dist[w].load(std::memory_order_relaxed) == next_dist &&
+			           claim(left_claim[w])) {
+				stack.push_back(w);
+				continue;
+			}
+			arc++;
+		}
+		return false;
+	}
+
+  public:
+	ParallelHopcroftKarp(const BipartiteGraph &graph, std::vector<std::size_t> &match_left,
+	                     std::vector<std::size_t> &match_right, std::size_t threads)
+	    : graph(graph), result_left(match_left), result_right(match_right), threads(threads),
+	      match_left(graph.left_num), match_right(graph.right_num), dist(graph.left_num),
+	      left_claim(graph.left_num), right_claim(graph.right_num), current_arc(graph.left_num),
+	      next_frontier(threads), stacks(threads) {
+		for (std::size_t u = 0; u < graph.left_num; u++) {
+			this->match_left[u].store(match_left[u], std::memory_order_relaxed);
+		}
+		for (std::size_t v = 0; v < graph.right_num; v++) {
+			this->match_right[v].store(match_right[v], std::memory_order_relaxed);
+		}
+	}
+
+	/**
+	 * @brief Extends the current matching to a maximum one.
+	 */
+	void run() {
+		bool stalled = false;
+		while (!stalled && layer()) {
+			phase++;
+			std::copy(graph.offsets.begin(), graph.offsets.end() - 1, current_arc.begin());
+
+			std::atomic<std::size_t> augmented{0};
+			const auto search = [&](std::size_t begin, std::size_t end, std::size_t thread) {
+				for (std::size_t i = begin; i < end; i++) {
+					if (augment(roots[i], stacks[thread])) {
+						augmented.fetch_add(1, std::memory_order_relaxed);
+					}
+				}
+			};
+			parallel_for(threads, roots.size(), DFS_GRAIN, search);
+			stalled = augmented.load() == 0;
+		}
+
+		for (std::size_t u = 0; u < graph.left_num; u++) {
+			result_left[u] = match_left[u].load(std::memory_order_relaxed);
+		}
+		for (std::size_t v = 0; v < graph.right_num; v++) {
+			result_right[v] = match_right[v].load(std::memory_order_relaxed);
+		}
+		if (stalled) hopcroft_karp(graph, result_left, result_right);
+	}
+};
+
+/**
+ * @brief Connected components of the graph given by their left vertices.
+ * @details Left vertices of component i are `lefts[offsets[i]] ... lefts[offsets[i + 1] - 1]` in
+ * increasing order. Left vertices without edges are skipped.
+ */
+struct Components {
+	std::vector<std::size_t> offsets;
+	std::vector<std::size_t> lefts;
+};
+
+/**
+ * @brief Splits the graph into connected components with union-find over its edges.
+ */
+Components connected_components(const BipartiteGraph &graph) {
+	// vertices are numbered 0..left_num-1 for the left and left_num.. for the right partition
+	std::vector<std::size_t> parent(graph.left_num + graph.right_num);
+	for (std::size_t x = 0; x < parent.size(); x++) {
+		parent[x] = x;
+	}
+	const auto find = [&parent](std::size_t x) {
+		while (parent[x] != x) {
+			parent[x] = parent[parent[x]];
+			x = parent[x];
+		}
+		return x;
+	};
+	for (std::size_t u = 0; u < graph.left_num; u++) {
+		for (std::size_t e = graph.offsets[u]; e < graph.offsets[u + 1]; e++) {
+			const std::size_t a = find(u);
+			const std::size_t b = find(graph.left_num + graph.targets[e]);
+			if (a != b) parent[std::max(a, b)] = std::min(a, b);
+		}
+	}
+
+	// the root of every component is its smallest left vertex, so it is numbered first
+	std::vector<std::size_t> component(graph.left_num, NIL);
+	Components result;
+	result.offsets.push_back(0);
+	for (std::size_t u = 0; u < graph.left_num; u++) {
+		if (graph.offsets[u] == graph.offsets[u + 1]) continue;
+		const std::size_t root = find(u);
+		if (root == u) {
+			component[u] = result.offsets.size() - 1;
+			result.offsets.push_back(0);
+		}
+		component[u] = component[root];
+		result.offsets[component[u] + 1]++;
+	}
+	for (std::size_t c = 0; c + 1 < result.offsets.size(); c++) {
+		result.offsets[c + 1] += result.offsets[c];
+	}
+	std::vector<std::size_t> position(result.offsets.begin(), result.offsets.end() - 1);
+	result.lefts.resize(result.offsets.back());
+	for (std::size_t u = 0; u < graph.left_num; u++) {
+		if (component[u] != NIL) result.lefts[position[component[u]]++] = u;
+	}
+
+	return result;
+}
+
+/**
+ * @brief Solves a small connected component with a greedy matching followed by simple
+ * augmenting path searches.
+ * @details Uses only the shared per-vertex arrays and a reused stack, so nothing is allocated per
+ * component. The workspace distance of a left vertex is set to the root of the search that
+ * visited it.
+ */
+void solve_small_component(const BipartiteGraph &graph, std::vector<std::size_t> &match_left,
+                           std::vector<std::size_t> &match_right, SearchWorkspace &workspace,
+                           const std::size_t *lefts_begin, const std::size_t *lefts_end,
+                           std::vector<std::size_t> &stack) {
+	std::vector<std::size_t> &visited = workspace.dist;
+	std::vector<std::size_t> &current_arc = workspace.current_arc;
+
+	for (const std::size_t *it = lefts_begin; it != lefts_end; it++) {
+		visited[*it] = NIL;
+		if (match_left[*it] != NIL) continue;
+		for (std::size_t e = graph.offsets[*it]; e < graph.offsets[*it + 1]; e++) {
+			const std::size_t v = graph.targets[e];
+			if (match_right[v] == NIL) {
+				match_left[*it] = v;
+				match_right[v] = *it;
+				break;
+			}
+		}
+	}
+
+	for (const std::size_t *it = lefts_begin; it != lefts_end; it++) {
+		const std::size_t root = *it;
+		if (match_left[root] != NIL) continue;
+
+		visited[root] = root;
+		current_arc[root] = graph.offsets[root];
+		stack.assign(1, root);
+		while (!stack.empty()) {
+			const std::size_t u = stack.back();
+			std::size_t &arc = current_arc[u];
+
+			if (arc == graph.offsets[u + 1]) {
+				stack.pop_back();
+				if (!stack.empty()) current_arc[stack.back()]++;
+				continue;
+			}
+
+			const std::size_t w = match_right[graph.targets[arc]];
+			if (w == NIL) {
+				for (const std::size_t left : stack) {
+					const std::size_t right = graph.targets[current_arc[left]];
+					match_left[left] = right;
+					match_right[right] = left;
+				}
+				break;
+			}
+
+			if (visited[w] != root) {
+				visited[w] = root;
+				current_arc[w] = graph.offsets[w];
+				stack.push_back(w);
+			} else {
+				arc++;
+			}
+		}
+	}
+}
+
+/**
+ * @brief Solves every connected component independently, distributing them between threads.
+ * @details Components are processed from the largest one for better load balancing. They do not
+ * share vertices, so all of them work in place on the same matching and workspace arrays.
+ */
+void solve_components(const BipartiteGraph &graph, std::vector<std::size_t> &match_left,
+                      std::vector<std::size_t> &match_right, std::size_t threads) {
+	constexpr std::size_t SMALL_COMPONENT = 64;
+
+	const Components components = connected_components(graph);
+	const std::size_t count = components.offsets.size() - 1;
+	const auto component_size = [&components](std::size_t c) {
+		return components.offsets[c + 1] - components.offsets[c];
+	};
+
+	std::vector<std::size_t> order(count);
+	for (std::size_t c = 0; c < count; c++) {
+		order[c] = c;
+	}
+	std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+		return component_size(a) > component_size(b);
+	});
+
+	SearchWorkspace workspace(graph);
+	std::vector<std::vector<std::size_t>> stacks(threads);
+	const auto solve = [&](std::size_t begin, std::size_t end, std::size_t thread) {
+		for (std::size_t i = begin; i < end; i++) {
+			const std::size_t c = order[i];
+			const std::size_t *first = components.lefts.data() + components.offsets[c];
+			const std::size_t *last = components.lefts.data() + components.offsets[c + 1];
+			if (component_size(c) <= SMALL_COMPONENT) {
+				solve_small_component(graph, match_left, match_right, workspace, first, last,
+				                      stacks[thread]);
+			} else {
+				HopcroftKarp(graph, match_left, match_right, workspace, first, last).run();
+			}
+		}
+	};
+	parallel_for(threads, count, 1, solve);
 }
 
 /**
  * @brief Find a maximum cardinality matching in a bipartite graph.
+ * @details Uses the Hopcroft-Karp algorithm on a sparse adjacency structure, so it runs in
+ * O(E sqrt(V)) time and O(V + E) memory. Unless disabled in `options`, the search starts from the
+ * given initial matching extended with Karp-Sipser degree-1 reduction and a greedy matching, which
+ * leaves only a few augmenting phases on graphs with a near-perfect matching. The phases can be
+ * run on multiple threads, which gives a matching of the same size. Graphs made of many
+ * independent parts can instead be split into connected components solved in parallel.
  * @param pairs: Pairs of connected vertices. Indexing in each partition is separate.
- * @return Pairs of matched vertices.
+ * @param options: warm start and threading settings, see MatchingOptions
+ * @return Pairs of matched vertices sorted by the index of the left vertex.
  */
 std::vector<std::pair<std::size_t, std::size_t>>
-bipartite_maximum_matching(const std::vector<std::pair<std::size_t, std::size_t>> &pairs) {
+bipartite_maximum_matching(const std::vector<std::pair<std::size_t, std::size_t>> &pairs,
+                           const MatchingOptions &options) {
 	if (pairs.empty()) {
 		return {};
 	}
-	size_t max_left = 0;
-	size_t max_right = 0;
-	for (const auto &pair : pairs) {
-		max_left = std::max(max_left, pair.first);
-		max_right = std::max(max_right, pair.second);
-	}
-
-	const size_t left_num = max_left + 1;
-	const size_t right_num = max_right + 1;
-	const size_t vertices_num = left_num + right_num;
 
-	const size_t source = vertices_num;
-	const size_t sink = source + 1;
+	const BipartiteGraph graph = build_graph(pairs);
+	std::vector<std::size_t> match_left(graph.left_num, NIL);
+	std::vector<std::size_t> match_right(graph.right_num, NIL);
 
-	std::vector<std::vector<int_fast8_t>> network(vertices_num + 2,
-	                                              std::vector<int_fast8_t>(vertices_num + 2, 0));
+	apply_initial_matching(graph, options.initial_matching, match_left, match_right);
+	if (options.warm_start) {
+		karp_sipser(graph, match_left, match_right);
+		greedy_matching(graph, match_left, match_right);
+	}
 
-	for (size_t i = 0; i < left_num; i++) {
-		network[source][i] = 1;
+	const std::size_t threads = resolve_threads(options.threads);
+	if (options.split_components) {
+		solve_components(graph, match_left, match_right, threads);
+	} else if (threads > 1) {
+		ParallelHopcroftKarp(graph, match_left, match_right, threads).run();
+	} else {
+		hopcroft_karp(graph, match_left, match_right);
 	}
-	for (size_t i = 0; i < right_num; i++) {
-		network[left_num + i][sink] = 1;
+
+	std::vector<std::pair<std::size_t, std::size_t>> result;
+	for (std::size_t u = 0; u < graph.left_num; u++) {
+		if (match_left[u] != NIL) {
+			result.emplace_back(u, match_left[u]);
+		}
 	}
 
-	for (const auto &pair : pairs) {
-		network[pair.first][left_num + pair.second] = 1;
+	return result;
+}
+
+/**
+ * @brief Find a maximum b-matching in a bipartite graph.
+ * @details Every vertex can be matched with as many vertices as its capacity and every pair can
+ * be used once, even if it is given several times. Solved as a maximum flow on a network where the
+ * capacities are put on the source and sink edges, so the network has V + 2 vertices and at most
+ * V + E edges regardless of the capacities.
+ * @param pairs: Pairs of connected vertices. Indexing in each partition is separate.
+ * @param left_capacity: capacities of the left vertices, missing values are treated as 1
+ * @param right_capacity: capacities of the right vertices, missing values are treated as 1
+ * @param algorithm: maximum flow algorithm, push-relabel is usually faster on dense graphs
+ * @return Pairs of matched vertices sorted by the index of the left vertex.
+ */
+std::vector<std::pair<std::size_t, std::size_t>>
+bipartite_b_matching(const std::vector<std::pair<std::size_t, std::size_t>> &pairs,
+                     const std::vector<std::size_t> &left_capacity,
+                     const std::vector<std::size_t> &right_capacity,
+                     FlowNetwork::Algorithm algorithm) {
+	if (pairs.empty()) {
+		return {};
 	}
 
-	auto flow_result = maxflow(source, network, sink);
+	const BipartiteGraph graph = build_graph(pairs);
+	const auto capacity = [](const std::vector<std::size_t> &capacities, std::size_t vertex) {
+		return static_cast<FlowNetwork::Capacity>(vertex < capacities.size() ? capacities[vertex]
+		                                                                     : 1);
+	};
 
-	std::vector<std::pair<size_t, size_t>> result;
+	const std::size_t source = graph.left_num + graph.right_num;
+	const std::size_t sink = source + 1;
+	FlowNetwork network(sink + 1);
 
-	for (size_t i = 0; i < left_num; i++) {
-		for (size_t j = 0; j < right_num; j++) {
-			if (flow_result[i][left_num + j] > 0) {
-				result.emplace_back(i, j);
-			}
+	for (std::size_t u = 0; u < graph.left_num; u++) {
+		network.add_edge(source, u, capacity(left_capacity, u));
+	}
+	// rows are grouped by the left vertex, so a repeated pair is found by remembering the last row
+	// in which every right vertex was seen
+	std::vector<std::size_t> seen_in_row(graph.right_num, NIL);
+	const std::size_t first_pair_edge = network.edges_num();
+	for (std::size_t u = 0; u < graph.left_num; u++) {
+		for (std::size_t e = graph.offsets[u]; e < graph.offsets[u + 1]; e++) {
+			const std::size_t v = graph.targets[e];
+			if (seen_in_row[v] == u) continue;
+			seen_in_row[v] = u;
+			network.add_edge(u, graph.left_num + v, 1);
+		}
+	}
+	const std::size_t last_pair_edge = network.edges_num();
+	for (std::size_t v = 0; v < graph.right_num; v++) {
+		network.add_edge(graph.left_num + v, sink, capacity(right_capacity, v));
+	}
+
+	network.max_flow(source, sink, algorithm);
+
+	std::vector<std::pair<std::size_t, std::size_t>> result;
+	for (const auto &edge : network.flow_edges()) {
+		if (edge.id >= first_pair_edge && edge.id < last_pair_edge) {
+			result.emplace_back(edge.from, edge.to - graph.left_num);
 		}
 	}
 
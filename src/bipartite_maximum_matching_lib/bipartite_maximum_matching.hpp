@@ -5,10 +5,44 @@
 #include <utility>
 #include <vector>
 
+#include "flow_network.hpp"
+
 namespace bipartite_maximum_matching {
 
+/**
+ * @brief options for bipartite_maximum_matching::bipartite_maximum_matching()
+ */
+struct MatchingOptions {
+	/**
+	 * @brief seed the augmenting path search with Karp-Sipser degree-1 reduction and a greedy
+	 * matching
+	 */
+	bool warm_start = true;
+	/**
+	 * @brief matching to start from (e.g. a previous assignment), pairs that are not edges of the
+	 * graph or conflict with earlier pairs are ignored
+	 */
+	std::vector<std::pair<std::size_t, std::size_t>> initial_matching;
+	/**
+	 * @brief number of threads used by the augmenting path search, 0 means all hardware threads
+	 */
+	std::size_t threads = 1;
+	/**
+	 * @brief solve every connected component separately, with the components distributed between
+	 * the threads instead of parallelizing the search inside one graph
+	 */
+	bool split_components = false;
+};
+
+std::vector<std::pair<std::size_t, std::size_t>>
+bipartite_maximum_matching(const std::vector<std::pair<std::size_t, std::size_t>> &pairs,
+                           const MatchingOptions &options = {});
+
 std::vector<std::pair<std::size_t, std::size_t>>
-bipartite_maximum_matching(const std::vector<std::pair<std::size_t, std::size_t>> &pairs);
+bipartite_b_matching(const std::vector<std::pair<std::size_t, std::size_t>> &pairs,
+                     const std::vector<std::size_t> &left_capacity,
+                     const std::vector<std::size_t> &right_capacity,
+                     FlowNetwork::Algorithm algorithm = FlowNetwork::Algorithm::dinic);
 
 }
 
@@ -0,0 +1,287 @@
+#include "dynamic_matcher.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "bipartite_maximum_matching.hpp"
+
+namespace bipartite_maximum_matching {
+
+constexpr std::size_t UNMATCHED = std::numeric_limits<std::size_t>::max();
+
+/**
+ * @brief Creates a matcher for the given graph and computes its maximum matching from scratch.
+ * @param pairs: Pairs of connected vertices. Indexing in each partition is separate.
+ */
+DynamicMatcher::DynamicMatcher(const std::vector<std::pair<std::size_t, std::size_t>> &pairs) {
+	for (const auto &pair : pairs) {
+		if (pair.first >= adj_left.size() || pair.second >= adj_right.size()) {
+			resize(std::max(adj_left.size(), pair.first + 1),
+			       std::max(adj_right.size(), pair.second + 1));
+		}
+		auto &neighbours = adj_left[pair.first];
+		if (std::find(neighbours.begin(), neighbours.end(), pair.second) == neighbours.end()) {
+			neighbours.push_back(pair.second);
+			adj_right[pair.second].push_back(pair.first);
+		}
+	}
+	for (const auto &pair : bipartite_maximum_matching(pairs)) {
+		match(pair.first, pair.second);
+		matched++;
+	}
+}
+
+void DynamicMatcher::resize(std::size_t left_size, std::size_t right_size) {
+	adj_left.resize(left_size);
+	match_left.resize(left_size, UNMATCHED);
+	left_seen.resize(left_size, 0);
+	left_parent.resize(left_size);
+
+	adj_right.resize(right_size);
+	match_right.resize(right_size, UNMATCHED);
+	right_seen.resize(right_size, 0);
+	right_parent.resize(right_size);
+}
+
+void DynamicMatcher::match(std::size_t left, std::size_t right) {
+	match_left[left] = right;
+	match_right[right] = left;
+}
+
+/**
+ * @brief Adds an isolated vertex to the left partition.
+ * @return index of the new vertex
+ */
+std::size_t DynamicMatcher::add_left_vertex() {
+	resize(adj_left.size() + 1, adj_right.size());
+	return adj_left.size() - 1;
+}
+
+/**
+ * @brief Adds an isolated vertex to the right partition.
+ * @return index of the new vertex
+ */
+std::size_t DynamicMatcher::add_right_vertex() {
+	resize(adj_left.size(), adj_right.size() + 1);
+	return adj_right.size() - 1;
+}
+
+/**
+ * @brief Alternating BFS from a left vertex towards a free right vertex.
+ * @details Left vertices are left through unmatched edges and right vertices through their
+ * matching edge. Parents of reached right vertices are stored in right_parent.
+ * @return the free right vertex found or UNMATCHED
+ */
+std::size_t DynamicMatcher::find_free_right(std::size_t start) {
+	stamp++;
+	left_seen[start] = stamp;
+	queue.assign(1, start);
+	for (std::size_t i = 0; i < queue.size(); i++) {
+		const std::size_t left = queue[i];
+		for (const std::size_t right : adj_left[left]) {
+			if (right == match_left[left] || right_seen[right] == stamp) continue;
+			right_seen[right] = stamp;
+			right_parent[right] = left;
+
+			const std::size_t next = match_right[right];
+			if (next == UNMATCHED) return right;
+			if (left_seen[next] != stamp) {
+				left_seen[next] = stamp;
+				queue.push_back(next);
+			}
+		}
+	}
+	return UNMATCHED;
+}
+
+/**
+ * @brief Alternating BFS from a right vertex backwards towards a free left vertex.
+ * @details Mirror image of find_free_right(), parents are stored in left_parent.
+ * @return the free left vertex found or UNMATCHED
+ */
+std::size_t DynamicMatcher::find_free_left(std::size_t start) {
+	stamp++;
+	right_seen[start] = stamp;
+	queue.assign(1, start);
+	for (std::size_t i = 0; i < queue.size(); i++) {
+		const std::size_t right = queue[i];
+		for (const std::size_t left : adj_right[right]) {
+			if (left == match_right[right] || left_seen[left] == stamp) continue;
+			left_seen[left] = stamp;
+			left_parent[left] = right;
+
+			const std::size_t next = match_left[left];
+			if (next == UNMATCHED) return left;
+			if (right_seen[next] != stamp) {
+				right_seen[next] = stamp;
+				queue.push_back(next);
+			}
+		}
+	}
+	return UNMATCHED;
+}
+
+/**
+ * @brief Flips the path found by find_free_right() from `start` to `free_right`.
+ */
+void DynamicMatcher::augment_forward(std::size_t start, std::size_t free_right) {
+	std::size_t right = free_right;
+	while (true) {
+		const std::size_t left = right_parent[right];
+		const std::size_t next = match_left[left];
+		match(left, right);
+		if (left == start) break;
+		right = next;
+	}
+}
+
+/**
+ * @brief Flips the path found by find_free_left() from `start` to `free_left`.
+ */
+void DynamicMatcher::augment_reverse(std::size_t start, std::size_t free_left) {
+	std::size_t left = free_left;
+	while (true) {
+		const std::size_t right = left_parent[left];
+		const std::size_t next = match_right[right];
+		match(left, right);
+		if (right == start) break;
+		left = next;
+	}
+}
+
+/**
+ * @brief Adds an edge and restores a maximum matching.
+ * @details Any new augmenting path has to use the added edge, so it is enough to search for an
+ * alternating path from a free left vertex to `left` and from `right` to a free right vertex. The
+ * two halves are vertex-disjoint because the matching was maximum before the update. Missing
+ * vertices are added to the partitions.
+ * @param left: index of the left vertex
+ * @param right: index of the right vertex
+ * @return false if the edge was already present
+ */
+bool DynamicMatcher::add_edge(std::size_t left, std::size_t right) {
+	if (left >= adj_left.size() || right >= adj_right.size()) {
+		resize(std::max(adj_left.size(), left + 1), std::max(adj_right.size(), right + 1));
+	}
+	auto &neighbours = adj_left[left];
+	if (std::find(neighbours.begin(), neighbours.end(), right) != neighbours.end()) return false;
+	neighbours.push_back(right);
+	adj_right[right].push_back(left);
+
+	const bool left_free = match_left[left] == UNMATCHED;
+	const bool right_free = match_right[right] == UNMATCHED;
+
+	if (left_free && right_free) {
+		match(left, right);
+	} else if (left_free) {
+		const std::size_t free_right = find_free_right(left);
+		if (free_right == UNMATCHED) return true;
+		augment_forward(left, free_right);
+	} else if (right_free) {
+		const std::size_t free_left = find_free_left(right);
+		if (free_left == UNMATCHED) return true;
+		augment_reverse(right, free_left);
+	} else {
+		const std::size_t left_partner = match_left[left];
+		const std::size_t right_partner = match_right[right];
+
+		const std::size_t free_left = find_free_left(left_partner);
+		if (free_left == UNMATCHED) return true;
+		const std::size_t free_right = find_free_right(right_partner);
+		if (free_right == UNMATCHED) return true;
+
+		augment_reverse(left_partner, free_left);
+		augment_forward(right_partner, free_right);
+		match(left, right);
+	}
+
+	matched++;
+	return true;
+}
+
+/**
+ * @brief Removes an edge and restores a maximum matching.
+ * @details If the edge was matched, any augmenting path has to start in one of its endpoints, so
+ * at most two searches are needed.
+ * @param left: index of the left vertex
+ * @param right: index of the right vertex
+ * @return false if there was no such edge
+ */
+bool DynamicMatcher::remove_edge(std::size_t left, std::size_t right) {
+	if (left >= adj_left.size() || right >= adj_right.size()) return false;
+
+	auto &neighbours = adj_left[left];
+	const auto it = std::find(neighbours.begin(), neighbours.end(), right);
+	if (it == neighbours.end()) return false;
+	*it = neighbours.back();
+	neighbours.pop_back();
+
+	auto &reverse_neighbours = adj_right[right];
+	*std::find(reverse_neighbours.begin(), reverse_neighbours.end(), left) =
+	    reverse_neighbours.back();
+	reverse_neighbours.pop_back();
+
+	if (match_left[left] != right) return true;
+	match_left[left] = UNMATCHED;
+	match_right[right] = UNMATCHED;
+	matched--;
+
+	const std::size_t free_right = find_free_right(left);
+	if (free_right != UNMATCHED) {
+		augment_forward(left, free_right);
+		matched++;
+		return true;
+	}
+
+	const std::size_t free_left = find_free_left(right);
+	if (free_left != UNMATCHED) {
+		augment_reverse(right, free_left);
+		matched++;
+	}
+	return true;
+}
+
+std::size_t DynamicMatcher::left_num() const { return adj_left.size(); }
+
+std::size_t DynamicMatcher::right_num() const { return adj_right.size(); }
+
+/**
+ * @return number of edges in the current matching
+ */
+std::size_t DynamicMatcher::size() const { return matched; }
+
+/**
+ * @return right vertex matched with `left` or nullopt if it is free
+ */
+std::optional<std::size_t> DynamicMatcher::left_match(std::size_t left) const {
+	if (left >= match_left.size() || match_left[left] == UNMATCHED) return std::nullopt;
+	return match_left[left];
+}
+
+/**
+ * @return left vertex matched with `right` or nullopt if it is free
+ */
+std::optional<std::size_t> DynamicMatcher::right_match(std::size_t right) const {
+	if (right >= match_right.size() || match_right[right] == UNMATCHED) return std::nullopt;
+	return match_right[right];
+}
+
+/**
+ * @return pairs of matched vertices sorted by the index of the left vertex
+ */
+std::vector<std::pair<std::size_t, std::size_t>> DynamicMatcher::matching() const {
+	std::vector<std::pair<std::size_t, std::size_t>> result;
+	result.reserve(matched);
+	for (std::size_t left = 0; left < match_left.size(); left++) {
+		if (match_left[left] != UNMATCHED) {
+			result.emplace_back(left, match_left[left]);
+		}
+	}
+	return result;
+}
+
+}
@@ -0,0 +1,72 @@
+#ifndef DYNAMIC_MATCHER_HPP
+#define DYNAMIC_MATCHER_HPP
+
+#include <cstddef>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace bipartite_maximum_matching {
+
+/**
+ * @brief Maximum cardinality matching of a bipartite graph that changes over time.
+ * @details After every update the matching is restored to a maximum one with at most two
+ * alternating path searches limited to the part of the graph reachable from the changed edge.
+ */
+class DynamicMatcher {
+  public:
+	DynamicMatcher() = default;
+	explicit DynamicMatcher(const std::vector<std::pair<std::size_t, std::size_t>> &pairs);
+
+	std::size_t add_left_vertex();
+	std::size_t add_right_vertex();
+
+	bool add_edge(std::size_t left, std::size_t right);
+	bool remove_edge(std::size_t left, std::size_t right);
+
+	std::size_t left_num() const;
+	std::size_t right_num() const;
+	std::size_t size() const;
+
+	std::optional<std::size_t> left_match(std::size_t left) const;
+	std::optional<std::size_t> right_match(std::size_t right) const;
+
+	std::vector<std::pair<std::size_t, std::size_t>> matching() const;
+
+  private:
+	std::vector<std::vector<std::size_t>> adj_left;
+	std::vector<std::vector<std::size_t>> adj_right;
+
+	std::vector<std::size_t> match_left;
+	std::vector<std::size_t> match_right;
+	std::size_t matched = 0;
+
+	/**
+	 * @brief search bookkeeping, a vertex is visited if its entry equals the current stamp
+	 */
+	std::vector<std::size_t> left_seen;
+	std::vector<std::size_t> right_seen;
+	std::size_t stamp = 0;
+
+	/**
+	 * @brief left vertex from which a right vertex was reached during the last forward search
+	 */
+	std::vector<std::size_t> right_parent;
+	/**
+	 * @brief right vertex from which a left vertex was reached during the last reverse search
+	 */
+	std::vector<std::size_t> left_parent;
+	std::vector<std::size_t> queue;
+
+	void resize(std::size_t left_size, std::size_t right_size);
+	void match(std::size_t left, std::size_t right);
+
+	std::size_t find_free_right(std::size_t start);
+	std::size_t find_free_left(std::size_t start);
+	void augment_forward(std::size_t start, std::size_t free_right);
+	void augment_reverse(std::size_t start, std::size_t free_left);
+};
+
+}
+
+#endif
@@ -0,0 +1,386 @@
+#include "flow_network.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace bipartite_maximum_matching {
+
+constexpr std::size_t UNREACHED = std::numeric_limits<std::size_t>::max();
+
+/**
+ * @brief Creates a network without edges.
+ * @param vertices_num: number of vertices, vertices are indexed from 0
+ */
+FlowNetwork::FlowNetwork(std::size_t vertices_num) : vertices(vertices_num) {}
+
+std::size_t FlowNetwork::vertices_num() const { return vertices; }
+
+std::size_t FlowNetwork::edges_num() const { return capacity.size(); }
+
+/**
+ * @brief Adds a directed edge to the network.
+ * @details Flow already present in the network is kept, so edges can be added between calls to
+ * max_flow() to extend the current flow instead of computing it from scratch.
+ * @param from: tail of the edge
+ * @param to: head of the edge
+ * @param capacity: non-negative capacity of the edge
+ * @return index of the edge, used by flow() and FlowEdge::id
+ */
+std::size_t FlowNetwork::add_edge(std::size_t from, std::size_t to, Capacity capacity) {
+	if (from >= vertices || to >= vertices) {
+		throw std::out_of_range("edge vertex index out of range");
+	}
+	if (capacity < 0) {
+		throw std::invalid_argument("edge capacity must be non-negative");
+	}
+
+	head.push_back(to);
+	residual.push_back(capacity);
+	head.push_back(from);
+	residual.push_back(0);
+	this->capacity.push_back(capacity);
+	arcs_valid = false;
+
+	return this->capacity.size() - 1;
+}
+
+/**
+ * @brief Groups residual arcs by their tail vertex into a CSR structure.
+ */
+void FlowNetwork::build_arcs() {
+	arc_offsets.assign(vertices + 1, 0);
+	for (std::size_t arc = 0; arc < head.size(); arc++) {
+		arc_offsets[head[arc ^ 1U] + 1]++;
+	}
+	for (std::size_t v = 0; v < vertices; v++) {
+		arc_offsets[v + 1] += arc_offsets[v];
+	}
+
+	std::vector<std::size_t> position(arc_offsets.begin(), arc_offsets.end() - 1);
+	arcs.resize(head.size());
+	for (std::size_t arc = 0; arc < head.size(); arc++) {
+		arcs[position[head[arc ^ 1U]]++] = arc;
+	}
+
+	level.resize(vertices);
+	current_arc.resize(vertices);
+	arcs_valid = true;
+}
+
+/**
+ * @brief Computes BFS distances from the source in the residual network.
+ * @returns true if the sink is reachable.
+ */
+bool FlowNetwork::dinic_layer(std::size_t source, std::size_t sink) {
+	std::fill(level.begin(), level.end(), UNREACHED);
+	std::vector<std::size_t> queue = {source};
+	level[source] = 0;
+
+	for (std::size_t i = 0; i < queue.size() && level[sink] == UNREACHED; i++) {
+		const std::size_t u = queue[i];
+		for (std::size_t j = arc_offsets[u]; j < arc_offsets[u + 1]; j++) {
+			const std::size_t arc = arcs[j];
+			if (residual[arc] > 0 && level[head[arc]] == UNREACHED) {
+				level[head[arc]] = level[u] + 1;
+				queue.push_back(head[arc]);
+			}
+		}
+	}
+
+	return level[sink] != UNREACHED;
+}
+
+/**
+ * @brief Finds a blocking flow in the level graph.
+ * @details Iterative DFS with current-arc pointers: after every augmentation the search resumes
+ * from the tail of the first saturated arc and vertices without a way forward are removed from
+ * the level graph, so each phase takes O(VE).
+ * @returns amount of flow pushed during the phase.
+ */
+FlowNetwork::Capacity FlowNetwork::dinic_blocking_flow(std::size_t source, std::size_t sink) {
+	std::copy(arc_offsets.begin(), arc_offsets.end() - 1, current_arc.begin());
+
+	Capacity total = 0;
+	std::vector<std::size_t> path;
+	std::size_t u = source;
+	while (true) {
+		if (u == sink) {
+			Capacity pushed = std::numeric_limits<Capacity>::max();
+			for (const std::size_t arc : path) {
+				pushed = std::min(pushed, residual[arc]);
+			}
+			std::size_t saturated = path.size();
+			for (std::size_t i = 0; i < path.size(); i++) {
+				residual[path[i]] -= pushed;
+				residual[path[i] ^ 1U] += pushed;
+				if (residual[path[i]] == 0 && saturated == path.size()) saturated = i;
+			}
+			total += pushed;
+
+			path.resize(saturated);
+			u = path.empty() ? source : head[path.back()];
+			continue;
+		}
+
+		std::size_t &j = current_arc[u];
+		while (j < arc_offsets[u + 1] &&
+		       (residual[arcs[j]] == 0 || level[head[arcs[j]]] != level[u] + 1)) {
+			j++;
+		}
+
+		if (j < arc_offsets[u + 1]) {
+			path.push_back(arcs[j]);
+			u = head[arcs[j]];
+		} else {
+			if (u == source) break;
+			level[u] = UNREACHED;
+			path.pop_back();
+			u = path.empty() ? source : head[path.back()];
+			current_arc[u]++;
+		}
+	}
+
+	return total;
+}
+
+/**
+ * @brief Sets exact distance labels with reverse BFS in the residual network.
+ * @details Vertices which can reach the sink get their distance to it. In the second phase,
+ * vertices which can only reach the source get V plus their distance to the source, they return
+ * their excess to it. All other vertices get label 2V, so they are never pushed to.
+ */
+void FlowNetwork::global_relabel(std::size_t source, std::size_t sink) {
+	const std::size_t n = vertices;
+	std::fill(level.begin(), level.end(), 2 * n);
+	std::fill(label_count.begin(), label_count.end(), 0);
+	for (auto &bucket : active) {
+		bucket.clear();
+	}
+	for (auto &bucket : labeled) {
+		bucket.clear();
+	}
+	highest_active = 0;
+	highest_label = 0;
+
+	std::vector<std::size_t> queue;
+	const auto search = [&](std::size_t root) {
+		queue.assign(1, root);
+		for (std::size_t i = 0; i < queue.size(); i++) {
+			const std::size_t v = queue[i];
+			for (std::size_t j = arc_offsets[v]; j < arc_offsets[v + 1]; j++) {
+				const std::size_t u = head[arcs[j]];
+				if (residual[arcs[j] ^ 1U] > 0 && level[u] == 2 * n) {
+					level[u] = level[v] + 1;
+					queue.push_back(u);
+				}
+			}
+		}
+	};
+	level[sink] = 0;
+	level[source] = n;
+	search(sink);
+	if (label_limit > n) search(source);
+
+	for (std::size_t v = 0; v < n; v++) {
+		label_count[level[v]]++;
+		current_arc[v] = arc_offsets[v];
+		if (level[v] < n) {
+			labeled[level[v]].push_back(v);
+			highest_label = std::max(highest_label, level[v]);
+		}
+		if (excess[v] > 0 && v != source && v != sink && level[v] < label_limit) {
+			active[level[v]].push_back(v);
+			highest_active = std::max(highest_active, level[v]);
+		}
+	}
+}
+
+/**
+ * @brief Lifts a vertex without admissible arcs just above its lowest residual neighbour.
+ * @details When the old label of the vertex below V is left empty, no vertex above it can
+ * reach the sink anymore (gap heuristic), so they are all lifted to V + 1 at once.
+ */
+void FlowNetwork::relabel(std::size_t u) {
+	const std::size_t n = vertices;
+	const std::size_t old_level = level[u];
+
+	std::size_t new_level = 2 * n;
+	for (std::size_t j = arc_offsets[u]; j < arc_offsets[u + 1]; j++) {
+		if (residual[arcs[j]] > 0) {
+			new_level = std::min(new_level, level[head[arcs[j]]] + 1);
+		}
+	}
+	label_count[old_level]--;
+	level[u] = new_level;
+	label_count[new_level]++;
+	current_arc[u] = arc_offsets[u];
+	if (new_level < n) {
+		labeled[new_level].push_back(u);
+		highest_label = std::max(highest_label, new_level);
+	}
+
+	if (old_level < n && label_count[old_level] == 0) {
+		for (std::size_t label = old_level + 1; label <= highest_label; label++) {
+			for (const std::size_t v : labeled[label]) {
+				if (level[v] != label) continue;
+				label_count[label]--;
+				level[v] = n + 1;
+				label_count[n + 1]++;
+				current_arc[v] = arc_offsets[v];
+			}
+			labeled[label].clear();
+		}
+		highest_label = old_level;
+	}
+}
+
+/**
+ * @brief Pushes the whole excess of a vertex along admissible arcs, relabeling it when needed.
+ * @details Stops early when the vertex is lifted to label_limit or above.
+ */
+void FlowNetwork::discharge(std::size_t u, std::size_t source, std::size_t sink) {
+	while (excess[u] > 0 && level[u] < label_limit) {
+		std::size_t &j = current_arc[u];
+		if (j == arc_offsets[u + 1]) {
+			relabel(u);
+			continue;
+		}
+
+		const std::size_t arc = arcs[j];
+		const std::size_t v = head[arc];
+		if (residual[arc] > 0 && level[u] == level[v] + 1) {
+			const Capacity pushed = std::min(excess[u], residual[arc]);
+			residual[arc] -= pushed;
+			residual[arc ^ 1U] += pushed;
+			if (excess[v] == 0 && v != source && v != sink && level[v] < label_limit) {
+				active[level[v]].push_back(v);
+				highest_active = std::max(highest_active, level[v]);
+			}
+			excess[u] -= pushed;
+			excess[v] += pushed;
+		}
+		if (excess[u] > 0) j++;
+	}
+}
+
+/**
+ * @brief Computes a maximum flow with the highest-label push-relabel algorithm.
+ * @details Runs in O(V^2 sqrt(E)). Labels below V are distances to the sink and labels from V
+ * up are distances to the source. Exact labels are recomputed by global_relabel() after every
+ * O(V + E) work done by relabel().
+ * @returns amount of flow added to the sink.
+ */
+FlowNetwork::Capacity FlowNetwork::push_relabel(std::size_t source, std::size_t sink) {
+	const std::size_t n = vertices;
+	excess.assign(n, 0);
+	active.resize(2 * n + 1);
+	labeled.resize(n);
+	label_count.resize(2 * n + 1);
+
+	for (std::size_t j = arc_offsets[source]; j < arc_offsets[source + 1]; j++) {
+		const std::size_t arc = arcs[j];
+		excess[head[arc]] += residual[arc];
+		excess[source] -= residual[arc];
+		residual[arc ^ 1U] += residual[arc];
+		residual[arc] = 0;
+	}
+
+	// the first phase moves as much excess as possible to the sink, the second one returns what is
+	// left to the source, in both only vertices labeled below label_limit are active
+	const std::size_t relabel_period = n + head.size();
+	for (const std::size_t limit : {n, 2 * n}) {
+		label_limit = limit;
+		if (limit > n) {
+			bool stuck = false;
+			for (std::size_t v = 0; v < n && !stuck; v++) {
+				stuck = excess[v] > 0 && v != source && v != sink;
+			}
+			if (!stuck) break;
+		}
+		global_relabel(source, sink);
+		std::size_t work = 0;
+		while (true) {
+			while (highest_active > 0 && active[highest_active].empty()) {
+				highest_active--;
+			}
+			if (active[highest_active].empty()) break;
+
+			const std::size_t u = active[highest_active].back();
+			active[highest_active].pop_back();
+			const std::size_t old_level = level[u];
+			discharge(u, source, sink);
+
+			if (level[u] != old_level) {
+				work += arc_offsets[u + 1] - arc_offsets[u] + 1;
+				if (work >= relabel_period) {
+					global_relabel(source, sink);
+					work = 0;
+				}
+			}
+		}
+	}
+
+	return excess[sink];
+}
+
+/**
+ * @brief Computes a maximum flow.
+ * @details Dinic's algorithm with current-arc optimization runs in O(V^2 E) in general and
+ * O(E sqrt(V)) on unit capacity bipartite networks. Push-relabel runs in O(V^2 sqrt(E)) and
+ * does less work on dense networks. Both work on the same residual arcs and start from the flow
+ * already in the network, which can be read with flow() and flow_edges().
+ * @param source: index of the source vertex
+ * @param sink: index of the sink vertex
+ * @param algorithm: algorithm used to find the flow
+ * @return value of the flow added by this call
+ */
+FlowNetwork::Capacity FlowNetwork::max_flow(std::size_t source, std::size_t sink,
+                                            Algorithm algorithm) {
+	if (source >= vertices || sink >= vertices) {
+		throw std::out_of_range("source or sink index out of range");
+	}
+	if (source == sink) {
+		throw std::invalid_argument("source and sink must be different");
+	}
+	if (!arcs_valid) build_arcs();
+
+	if (algorithm == Algorithm::push_relabel) {
+		return push_relabel(source, sink);
+	}
+
+	Capacity total = 0;
+	while (dinic_layer(source, sink)) {
+		total += dinic_blocking_flow(source, sink);
+	}
+	return total;
+}
+
+/**
+ * @param edge: index of the edge as returned by add_edge()
+ * @return flow on the edge
+ */
+FlowNetwork::Capacity FlowNetwork::flow(std::size_t edge) const {
+	if (edge >= capacity.size()) {
+		throw std::out_of_range("edge index out of range");
+	}
+	return capacity[edge] - residual[2 * edge];
+}
+
+/**
+ * @return edges carrying positive flow in the order in which they were added
+ */
+std::vector<FlowNetwork::FlowEdge> FlowNetwork::flow_edges() const {
+	std::vector<FlowEdge> result;
+	for (std::size_t edge = 0; edge < capacity.size(); edge++) {
+		const Capacity edge_flow = capacity[edge] - residual[2 * edge];
+		if (edge_flow > 0) {
+			result.push_back({edge, head[2 * edge + 1], head[2 * edge], capacity[edge], edge_flow});
+		}
+	}
+	return result;
+}
+
+}
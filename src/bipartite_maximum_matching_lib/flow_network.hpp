@@ -0,0 +1,116 @@
+#ifndef FLOW_NETWORK_HPP
+#define FLOW_NETWORK_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace bipartite_maximum_matching {
+
+/**
+ * @brief Directed flow network with integer capacities stored as sparse residual arcs.
+ */
+class FlowNetwork {
+  public:
+	using Capacity = std::int64_t;
+
+	/**
+	 * @brief maximum flow algorithm used by FlowNetwork::max_flow()
+	 */
+	enum class Algorithm {
+		/**
+		 * @brief blocking flows in level graphs, best for sparse and unit capacity networks
+		 */
+		dinic,
+		/**
+		 * @brief highest-label push-relabel with global relabeling and the gap heuristic, best
+		 * for dense networks
+		 */
+		push_relabel
+	};
+
+	/**
+	 * @brief edge of the network together with the flow assigned to it
+	 */
+	struct FlowEdge {
+		/**
+		 * @brief index of the edge as returned by FlowNetwork::add_edge()
+		 */
+		std::size_t id;
+		std::size_t from;
+		std::size_t to;
+		Capacity capacity;
+		Capacity flow;
+	};
+
+	explicit FlowNetwork(std::size_t vertices_num);
+
+	std::size_t vertices_num() const;
+	std::size_t edges_num() const;
+
+	std::size_t add_edge(std::size_t from, std::size_t to, Capacity capacity);
+
+	Capacity max_flow(std::size_t source, std::size_t sink,
+	                  Algorithm algorithm = Algorithm::dinic);
+
+	Capacity flow(std::size_t edge) const;
+
+	std::vector<FlowEdge> flow_edges() const;
+
+  private:
+	std::size_t vertices;
+
+	/**
+	 * @brief head vertex of every residual arc, arc `2i` is edge i and arc `2i + 1` its reverse
+	 */
+	std::vector<std::size_t> head;
+	/**
+	 * @brief remaining capacity of every residual arc
+	 */
+	std::vector<Capacity> residual;
+	/**
+	 * @brief original capacity of every edge
+	 */
+	std::vector<Capacity> capacity;
+
+	/**
+	 * @brief residual arcs grouped by their tail vertex (CSR), rebuilt lazily after add_edge()
+	 */
+	std::vector<std::size_t> arc_offsets;
+	std::vector<std::size_t> arcs;
+	bool arcs_valid = false;
+
+	/**
+	 * @brief BFS distance from the source for Dinic's algorithm, distance label for push-relabel
+	 */
+	std::vector<std::size_t> level;
+	std::vector<std::size_t> current_arc;
+
+	/**
+	 * @brief push-relabel state: excess of every vertex, active vertices grouped by label and
+	 * number of vertices with every label, vertices labeled label_limit or above are not active
+	 */
+	std::vector<Capacity> excess;
+	std::vector<std::vector<std::size_t>> active;
+	std::vector<std::size_t> label_count;
+	std::size_t highest_active = 0;
+	/**
+	 * @brief vertices grouped by labels below V for the gap heuristic, entries of vertices which
+	 * were relabeled since are skipped
+	 */
+	std::vector<std::vector<std::size_t>> labeled;
+	std::size_t highest_label = 0;
+	std::size_t label_limit = 0;
+
+	void build_arcs();
+	bool dinic_layer(std::size_t source, std::size_t sink);
+	Capacity dinic_blocking_flow(std::size_t source, std::size_t sink);
+	Capacity push_relabel(std::size_t source, std::size_t sink);
+	void global_relabel(std::size_t source, std::size_t sink);
+	void discharge(std::size_t u, std::size_t source, std::size_t sink);
+	void relabel(std::size_t u);
+};
+
+}
+
+#endif
@@ -0,0 +1,57 @@
+#ifndef PARALLEL_FOR_HPP
+#define PARALLEL_FOR_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace bipartite_maximum_matching {
+
+/**
+ * @brief Resolves a requested thread count, 0 means all hardware threads.
+ */
+inline std::size_t resolve_threads(std::size_t threads) {
+	if (threads != 0) return threads;
+	return std::max<std::size_t>(1, std::thread::hardware_concurrency());
+}
+
+/**
+ * @brief Runs `fn(begin, end, thread_index)` over blocks of `[0, count)` on `threads` threads.
+ * @details Blocks of `grain` indices are handed out dynamically, so uneven work is balanced
+ * between threads. When one thread is requested or the range fits in a single block, `fn` is
+ * called directly on the calling thread.
+ */
+template <typename Function>
+void parallel_for(std::size_t threads, std::size_t count, std::size_t grain, Function fn) {
+	grain = std::max<std::size_t>(grain, 1);
+	threads = std::min(threads, (count + grain - 1) / grain);
+	if (threads <= 1) {
+		if (count > 0) fn(std::size_t{0}, count, std::size_t{0});
+		return;
+	}
+
+	std::atomic<std::size_t> next{0};
+	const auto worker = [&](std::size_t thread_index) {
+		while (true) {
+			const std::size_t begin = next.fetch_add(grain, std::memory_order_relaxed);
+			if (begin >= count) break;
+			fn(begin, std::min(begin + grain, count), thread_index);
+		}
+	};
+
+	std::vector<std::thread> pool;
+	pool.reserve(threads - 1);
+	for (std::size_t t = 1; t < threads; t++) {
+		pool.emplace_back(worker, t);
+	}
+	worker(0);
+	for (auto &thread : pool) {
+		thread.join();
+	}
+}
+
+}
+
+#endif
@@ -0,0 +1,139 @@
+#include "streaming_matcher.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace bipartite_maximum_matching {
+
+constexpr std::size_t UNMATCHED = std::numeric_limits<std::size_t>::max();
+
+void StreamingMatcher::resize(std::size_t left_size, std::size_t right_size) {
+	match_left.resize(left_size, UNMATCHED);
+	left_layer.resize(left_size, UNMATCHED);
+	left_root.resize(left_size, UNMATCHED);
+
+	match_right.resize(right_size, UNMATCHED);
+	right_parent.resize(right_size, UNMATCHED);
+}
+
+/**
+ * @brief Feeds one edge of the current pass.
+ * @details Every pass should present the same edges, in any order. Vertices are added on the
+ * first occurrence of their index.
+ * @param left: index of the left vertex
+ * @param right: index of the right vertex
+ */
+void StreamingMatcher::add_edge(std::size_t left, std::size_t right) {
+	if (left >= match_left.size() || right >= match_right.size()) {
+		resize(std::max(match_left.size(), left + 1), std::max(match_right.size(), right + 1));
+	}
+
+	if (pass == 0) {
+		if (match_left[left] == UNMATCHED && match_right[right] == UNMATCHED) {
+			match_left[left] = right;
+			match_right[right] = left;
+			matched++;
+		}
+		return;
+	}
+
+	if (left_layer[left] != layer || right_parent[right] != UNMATCHED) return;
+	right_parent[right] = left;
+
+	const std::size_t next = match_right[right];
+	if (next == UNMATCHED) {
+		reached.push_back(right);
+	} else if (left_layer[next] == UNMATCHED) {
+		left_layer[next] = layer + 1;
+		left_root[next] = left_root[left];
+		grown = true;
+	}
+}
+
+/**
+ * @brief Ends the current pass over the edges.
+ * @return false if the matching is known to be maximum, true if another pass may improve it
+ */
+bool StreamingMatcher::finish_pass() {
+	pass++;
+
+	if (pass > 1 && reached.empty()) {
+		if (grown) {
+			// the forest got a new layer, the next pass continues the same phase
+			layer++;
+			grown = false;
+			return true;
+		}
+		// no free right vertex is reachable by an alternating path, so none can be augmenting
+		start_phase();
+		return false;
+	}
+
+	augment();
+	start_phase();
+	return matched < std::min(match_left.size(), match_right.size());
+}
+
+/**
+ * @brief Starts a new alternating forest rooted at the free left vertices.
+ */
+void StreamingMatcher::start_phase() {
+	for (std::size_t u = 0; u < match_left.size(); u++) {
+		const bool free = match_left[u] == UNMATCHED;
+		left_layer[u] = free ? 0 : UNMATCHED;
+		left_root[u] = free ? u : UNMATCHED;
+	}
+	std::fill(right_parent.begin(), right_parent.end(), UNMATCHED);
+	reached.clear();
+	layer = 0;
+	grown = false;
+}
+
+/**
+ * @brief Augments along forest paths to the reached free right vertices, one path per tree.
+ * @details Trees are vertex-disjoint, so the chosen paths are as well.
+ */
+void StreamingMatcher::augment() {
+	for (const std::size_t end : reached) {
+		const std::size_t root = left_root[right_parent[end]];
+		if (left_root[root] != root) continue;
+		left_root[root] = UNMATCHED;
+
+		std::size_t right = end;
+		while (true) {
+			const std::size_t left = right_parent[right];
+			const std::size_t next = match_left[left];
+			match_left[left] = right;
+			match_right[right] = left;
+			if (left == root) break;
+			right = next;
+		}
+		matched++;
+	}
+}
+
+/**
+ * @brief Number of finished passes over the edges.
+ */
+std::size_t StreamingMatcher::passes() const { return pass; }
+
+std::size_t StreamingMatcher::size() const { return matched; }
+
+/**
+ * @brief Pairs of matched vertices sorted by the index of the left vertex.
+ */
+std::vector<std::pair<std::size_t, std::size_t>> StreamingMatcher::matching() const {
+	std::vector<std::pair<std::size_t, std::size_t>> result;
+	result.reserve(matched);
+	for (std::size_t u = 0; u < match_left.size(); u++) {
+		if (match_left[u] != UNMATCHED) {
+			result.emplace_back(u, match_left[u]);
+		}
+	}
+	return result;
+}
+
+}
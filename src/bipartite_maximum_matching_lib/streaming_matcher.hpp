@@ -0,0 +1,63 @@
+#ifndef STREAMING_MATCHER_HPP
+#define STREAMING_MATCHER_HPP
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace bipartite_maximum_matching {
+
+/**
+ * @brief Matching of a bipartite graph read as a stream of edges, possibly in several passes.
+ * @details Only O(V) memory is used, edges are never stored. The first pass builds a maximal
+ * matching greedily, which is at least half of a maximum one. Every further pass over the same
+ * edges extends an alternating forest by one layer and augments the matching along the shortest
+ * augmenting paths once some are found.
+ */
+class StreamingMatcher {
+  public:
+	void add_edge(std::size_t left, std::size_t right);
+	bool finish_pass();
+
+	std::size_t passes() const;
+	std::size_t size() const;
+
+	std::vector<std::pair<std::size_t, std::size_t>> matching() const;
+
+  private:
+	std::vector<std::size_t> match_left;
+	std::vector<std::size_t> match_right;
+	std::size_t matched = 0;
+	std::size_t pass = 0;
+
+	/**
+	 * @brief pass of the current phase in which a left vertex joined the alternating forest
+	 */
+	std::vector<std::size_t> left_layer;
+	/**
+	 * @brief free left vertex at the root of the tree containing a left vertex
+	 */
+	std::vector<std::size_t> left_root;
+	/**
+	 * @brief left vertex from which a right vertex was reached, UNMATCHED if not reached yet
+	 */
+	std::vector<std::size_t> right_parent;
+	/**
+	 * @brief free right vertices reached during the current pass
+	 */
+	std::vector<std::size_t> reached;
+	/**
+	 * @brief index of the current pass within the phase, only left vertices of this layer are
+	 * extended
+	 */
+	std::size_t layer = 0;
+	bool grown = false;
+
+	void resize(std::size_t left_size, std::size_t right_size);
+	void start_phase();
+	void augment();
+};
+
+}
+
+#endif
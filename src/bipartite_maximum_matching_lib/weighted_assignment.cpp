@@ -0,0 +1,242 @@
+#include "weighted_assignment.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "parallel_for.hpp"
+
+namespace bipartite_maximum_matching {
+
+constexpr std::size_t UNASSIGNED = std::numeric_limits<std::size_t>::max();
+
+/**
+ * @brief Epsilon-scaling auction algorithm for the maximum weight bipartite matching.
+ * @details The auction solves symmetric assignment problems, so the matching problem with n left
+ * and m right vertices is turned into one with n + m bidders and n + m objects. Bidders are the
+ * left vertices and copies of the right vertices, objects are the right vertices and copies of
+ * the left vertices. Every pair (i, j) of weight w gives edges i -> j and j' -> i' of weight w,
+ * and every vertex is connected with its own copy by an edge of weight 0. A perfect assignment
+ * always exists, and its maximum weight is twice the maximum weight of a matching, with the left
+ * half being an optimal matching. Pairs of negative weight are never needed and are dropped.
+ *
+ * Bidding is Jacobi-style: in each round all unassigned bidders compute their bids against the
+ * same prices in parallel, then every object goes to its highest bidder (the lowest index on
+ * ties). The outcome does not depend on the number of threads.
+ */
+class Auction {
+	static constexpr double SCALING_FACTOR = 5;
+	static constexpr std::size_t GRAIN = 256;
+
+	std::size_t left_num = 0;
+	std::size_t right_num = 0;
+	std::size_t size = 0;
+	std::vector<std::size_t> offsets;
+	std::vector<std::size_t> objects;
+	std::vector<double> weights;
+
+	std::vector<double> price;
+	std::vector<std::size_t> assigned;
+	std::vector<std::size_t> owner;
+
+	std::vector<std::size_t> unassigned;
+	std::vector<std::size_t> next_unassigned;
+	std::vector<std::size_t> bid_object;
+	std::vector<double> bid_price;
+
+	std::vector<std::size_t> round_of_bid;
+	std::vector<std::size_t> best_bidder;
+	std::vector<double> best_bid;
+	std::vector<std::size_t> contested;
+	std::size_t round = 0;
+
+	std::size_t threads;
+	double epsilon = 0;
+
+	/**
+	 * @brief Computes the bid of the k-th unassigned bidder.
+	 * @details The bidder picks the object of the highest value (weight minus price) and raises
+	 * its price by the difference to the second best value plus epsilon.
+	 */
+	void bid(std::size_t k) {
+		const std::size_t i = unassigned[k];
+		double best = -std::numeric_limits<double>::infinity();
+		double second = best;
+		std::size_t best_object = UNASSIGNED;
+
+		for (std::size_t e = offsets[i]; e < offsets[i + 1]; e++) {
+			const double value = weights[e] - price[objects[e]];
+			if (value > best) {
+				second = best;
+				best = value;
+				best_object = objects[e];
+			} else if (value > second) {
+				second = value;
+			}
+		}
+		// a bidder with a single edge owns a private object nobody else competes for
+		if (second == -std::numeric_limits<double>::infinity()) second = best;
+
+		bid_object[k] = best_object;
+		bid_price[k] = price[best_object] + (best - second) + epsilon;
+	}
+
+	/**
+	 * @brief One round of parallel bidding followed by sequential assignment of the objects.
+	 */
+	void auction_round() {
+		bid_object.resize(unassigned.size());
+		bid_price.resize(unassigned.size());
+		parallel_for(threads, unassigned.size(), GRAIN,
+		             [this](std::size_t begin, std::size_t end, std::size_t /*thread*/) {
+			             for (std::size_t k = begin; k < end; k++) {
+				             bid(k);
+			             }
+		             });
+
+		round++;
+		contested.clear();
+		next_unassigned.clear();
+		for (std::size_t k = 0; k < unassigned.size(); k++) {
+			const std::size_t i = unassigned[k];
+			const std::size_t j = bid_object[k];
+
+			if (round_of_bid[j] != round) {
+				round_of_bid[j] = round;
+				best_bidder[j] = i;
+				best_bid[j] = bid_price[k];
+				contested.push_back(j);
+			} else if (bid_price[k] > best_bid[j]) {
+				next_unassigned.push_back(best_bidder[j]);
+				best_bidder[j] = i;
+				best_bid[j] = bid_price[k];
+			} else {
+				next_unassigned.push_back(i);
+			}
+		}
+
+		for (const std::size_t j : contested) {
+			price[j] = best_bid[j];
+			if (owner[j] != UNASSIGNED) {
+				assigned[owner[j]] = UNASSIGNED;
+				next_unassigned.push_back(owner[j]);
+			}
+			owner[j] = best_bidder[j];
+			assigned[best_bidder[j]] = j;
+		}
+
+		std::swap(unassigned, next_unassigned);
+	}
+
+  public:
+	Auction(const std::vector<WeightedPair> &pairs, std::size_t threads) : threads(threads) {
+		for (const auto &pair : pairs) {
+			left_num = std::max(left_num, pair.left + 1);
+			right_num = std::max(right_num, pair.right + 1);
+		}
+		size = left_num + right_num;
+
+		// bidder i < left_num is left vertex i, bidder left_num + j is the copy of right vertex j,
+		// object j < right_num is right vertex j, object right_num + i is the copy of left vertex i
+		offsets.assign(size + 1, 1);
+		offsets[0] = 0;
+		for (const auto &pair : pairs) {
+			if (pair.weight < 0) continue;
+			offsets[pair.left + 1]++;
+			offsets[left_num + pair.right + 1]++;
+		}
+		for (std::size_t i = 0; i < size; i++) {
+			offsets[i + 1] += offsets[i];
+		}
+
+		std::vector<std::size_t> position(offsets.begin(), offsets.end() - 1);
+		objects.resize(offsets.back());
+		weights.resize(offsets.back());
+		const auto add = [&](std::size_t bidder, std::size_t object, double weight) {
+			objects[position[bidder]] = object;
+			weights[position[bidder]++] = weight;
+		};
+		for (std::size_t i = 0; i < left_num; i++) {
+			add(i, right_num + i, 0);
+		}
+		for (std::size_t j = 0; j < right_num; j++) {
+			add(left_num + j, j, 0);
+		}
+		for (const auto &pair : pairs) {
+			if (pair.weight < 0) continue;
+			add(pair.left, pair.right, pair.weight);
+			add(left_num + pair.right, right_num + pair.left, pair.weight);
+		}
+
+		price.assign(size, 0);
+		assigned.assign(size, UNASSIGNED);
+		owner.assign(size, UNASSIGNED);
+		round_of_bid.assign(size, 0);
+		best_bidder.resize(size);
+		best_bid.resize(size);
+	}
+
+	/**
+	 * @brief Runs auctions with decreasing epsilon, keeping the prices between them.
+	 * @param final_epsilon: epsilon of the last auction, 0 selects `1 / (n + m + 1)`
+	 */
+	void run(double final_epsilon) {
+		if (final_epsilon <= 0) final_epsilon = 1.0 / static_cast<double>(size + 1);
+
+		double max_weight = 0;
+		for (const double weight : weights) {
+			max_weight = std::max(max_weight, weight);
+		}
+		epsilon = std::max(max_weight / 2, final_epsilon);
+
+		while (true) {
+			std::fill(assigned.begin(), assigned.end(), UNASSIGNED);
+			std::fill(owner.begin(), owner.end(), UNASSIGNED);
+			unassigned.resize(size);
+			for (std::size_t i = 0; i < size; i++) {
+				unassigned[i] = i;
+			}
+
+			while (!unassigned.empty()) {
+				auction_round();
+			}
+
+			if (epsilon <= final_epsilon) break;
+			epsilon = std::max(epsilon / SCALING_FACTOR, final_epsilon);
+		}
+	}
+
+	std::vector<std::pair<std::size_t, std::size_t>> result() const {
+		std::vector<std::pair<std::size_t, std::size_t>> result;
+		for (std::size_t i = 0; i < left_num; i++) {
+			if (assigned[i] < right_num) {
+				result.emplace_back(i, assigned[i]);
+			}
+		}
+		return result;
+	}
+};
+
+/**
+ * @brief Find a maximum weight matching in a bipartite graph.
+ * @details Uses the epsilon-scaling auction algorithm with bids computed in parallel. Vertices may
+ * stay unmatched, so pairs of negative weight are never used. To prefer a maximum cardinality
+ * matching of minimum cost, use `weight = C - cost` with C greater than the sum of all costs.
+ * @param pairs: Weighted pairs of connected vertices. Indexing in each partition is separate.
+ * @param options: number of threads and precision, see AssignmentOptions
+ * @return Pairs of matched vertices sorted by the index of the left vertex.
+ */
+std::vector<std::pair<std::size_t, std::size_t>>
+weighted_assignment(const std::vector<WeightedPair> &pairs, const AssignmentOptions &options) {
+	if (pairs.empty()) {
+		return {};
+	}
+
+	Auction auction(pairs, resolve_threads(options.threads));
+	auction.run(options.epsilon);
+	return auction.result();
+}
+
+}
@@ -0,0 +1,40 @@
+#ifndef WEIGHTED_ASSIGNMENT_HPP
+#define WEIGHTED_ASSIGNMENT_HPP
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace bipartite_maximum_matching {
+
+/**
+ * @brief edge of a weighted bipartite graph
+ */
+struct WeightedPair {
+	std::size_t left;
+	std::size_t right;
+	double weight;
+};
+
+/**
+ * @brief options for bipartite_maximum_matching::weighted_assignment()
+ */
+struct AssignmentOptions {
+	/**
+	 * @brief number of threads computing bids, 0 means all hardware threads
+	 */
+	std::size_t threads = 1;
+	/**
+	 * @brief final epsilon of the auction, the total weight is at most `(n + m) * epsilon` below
+	 * the optimum for n left and m right vertices. 0 selects `1 / (n + m + 1)`, which gives an
+	 * optimal matching for integer weights.
+	 */
+	double epsilon = 0;
+};
+
+std::vector<std::pair<std::size_t, std::size_t>>
+weighted_assignment(const std::vector<WeightedPair> &pairs, const AssignmentOptions &options = {});
+
+}
+
+#endif
@@ -1,10 +1,27 @@
 #include "convex_hull.hpp"
 
 #include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
+#include "parallel_chunks.hpp"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 /**
  * @brief convex hull
  */
@@ -27,10 +44,118 @@ double distance_sq(const Point &a, const Point &b) {
 	return (a.x - b.x) * (a.x - b.x) + (a.y - b.y) * (a.y - b.y);
 }
 
+/**
+ * @brief Adds two numbers exactly
+ * @param a first number
+ * @param b second number
+ * @param error output, `a + b - sum` computed exactly
+ * @returns the rounded sum
+ */
+double two_sum(double a, double b, double &error) {
+	const double sum = a + b;
+	const double b_virtual = sum - a;
+	const double a_virtual = sum - b_virtual;
+	error = (a - a_virtual) + (b - b_virtual);
+	return sum;
+}
+
+/**
+ * @brief Multiplies two numbers exactly with Dekker's splitting
+ * @param a first number
+ * @param b second number
+ * @param error output, `a * b - product` computed exactly
+ * @returns the rounded product
+ */
+double two_product(double a, double b, double &error) {
+	// 2^27 + 1, splits a double into two halves of at most 26 significant bits
+	constexpr double SPLITTER = 134217729.0;
+	const auto split = [](double value, double &high, double &low) {
+		const double c = SPLITTER * value;
+		high = c - (c - value);
+		low = value - high;
+	};
+
+	const double product = a * b;
+	double a_high = 0;
+	double a_low = 0;
+	double b_high = 0;
+	double b_low = 0;
+	split(a, a_high, a_low);
+	split(b, b_high, b_low);
+	error = a_low * b_low - (((product - a_high * b_high) - a_low * b_high) - a_high * b_low);
+	return product;
+}
+
+/**
+ * @brief Computes the orientation of three points exactly
+ * @details Sums products into a nonoverlapping expansion of floating-point numbers (Shewchuk's
+ * Grow-Expansion), whose largest component has the sign of the exact result. If the coordinate
+ * differences are exact, as for points on a grid or close to each other, the two products of the
+ * differences are enough, and if these are exact as well, their rounded difference. Otherwise the
+ * six products of the expanded determinant are summed.
+ * @returns the largest component of the exact orientation
+ */
+double exact_orientation(const Point &a, const Point &b, const Point &c) {
+	// two components per product in increasing order of magnitude, zeros are dropped
+	array<double, 12> expansion{};
+	size_t size = 0;
+	const auto grow = [&](double value) {
+		size_t kept = 0;
+		for (size_t i = 0; i < size; ++i) {
+			double error = 0;
+			value = two_sum(value, expansion[i], error);
+			if (error != 0) expansion[kept++] = error;
+		}
+		if (value != 0) expansion[kept++] = value;
+		size = kept;
+	};
+	const auto add_product = [&](double first, double second) {
+		double error = 0;
+		const double rounded = two_product(first, second, error);
+		grow(error);
+		grow(rounded);
+	};
+
+	array<double, 4> tails{};
+	const double ab_x = two_sum(a.x, -b.x, tails[0]);
+	const double ab_y = two_sum(a.y, -b.y, tails[1]);
+	const double cb_x = two_sum(c.x, -b.x, tails[2]);
+	const double cb_y = two_sum(c.y, -b.y, tails[3]);
+	if (tails == array<double, 4>{}) {
+		double left_error = 0;
+		double right_error = 0;
+		const double left = two_product(ab_x, cb_y, left_error);
+		const double right = two_product(ab_y, cb_x, right_error);
+		// the difference of two exact numbers is rounded with the correct sign
+		if (left_error == 0 && right_error == 0) return left - right;
+
+		grow(left_error);
+		grow(left);
+		grow(-right_error);
+		grow(-right);
+	} else {
+		add_product(a.x, c.y);
+		add_product(-a.x, b.y);
+		add_product(-b.x, c.y);
+		add_product(-a.y, c.x);
+		add_product(a.y, b.x);
+		add_product(b.y, c.x);
+	}
+	return size == 0 ? 0 : expansion[size - 1];
+}
+
+/**
+ * @brief relative error bound of the floating-point orientation, `(3 + 16 epsilon) epsilon` with
+ * `epsilon = 2^-53`
+ */
+constexpr double ORIENTATION_ERROR = (3.0 + 16.0 * 0x1p-53) * 0x1p-53;
+
 /**
  * @brief Computes the orientation of three points
  * @details Computes the orientation of three points using signed area of the triangle
- * formed by the points.
+ * formed by the points. The floating-point value is used if it exceeds its error bound, which
+ * holds for all but nearly collinear points, otherwise the sign is computed exactly (Shewchuk's
+ * adaptive predicate), so the sign is always correct.
  * @param a first point
  * @param b second point
  * @param c third point
@@ -39,52 +164,202 @@ double distance_sq(const Point &a, const Point &b) {
  * they are collinear.
  */
 double orientation(const Point &a, const Point &b, const Point &c) {
-	return (a.x - b.x) * (c.y - b.y) - (a.y - b.y) * (c.x - b.x);
+	const double left = (a.x - b.x) * (c.y - b.y);
+	const double right = (a.y - b.y) * (c.x - b.x);
+	const double det = left - right;
+	// Shewchuk tests the signs of the products first, which mispredicts on random input, the bound
+	// on their absolute values is never smaller and just as cheap
+	if (abs(det) >= ORIENTATION_ERROR * (abs(left) + abs(right))) return det;
+	return exact_orientation(a, b, c);
 }
 
 /**
- * @brief Computes a convex hull
- * @details Computes a convex hull using the Graham's scan algorithm in O(nlogn).
- * @param points vector of pairs where first is x coordinate and second is y coordinate of a point
- * @returns vector of input points indexes forming a convex hull in counter-clockwise order
- * starting from the point with the lowest y coordinate (and the lowest x coordinate in case of a
- * tie). The set of points is minimal, so if there are multiple points on the same line, only the
- * endpoints are included.
+ * @brief Computes the orientation of many points against one line
+ * @details Gives the floating-point values of `orientation(a, b, {xs[i], ys[i]})` without the exact
+ * fallback, so signs of nearly collinear points are not reliable. Computes four points at a time
+ * with AVX2, two with SSE2 or one by one otherwise.
+ * @param a first point of the line
+ * @param b second point of the line
+ * @param xs x coordinates of the third points
+ * @param ys y coordinates of the third points
+ * @param n number of the third points
+ * @param out output, n orientations
  */
-std::vector<std::size_t> convex_hull(const std::vector<Point> &points) {
-	if (points.empty()) return {};
-	if (points.size() == 1) return {0};
+void orientation_batch(const Point &a, const Point &b, const double *xs, const double *ys, size_t n,
+                       double *out) {
+	const double dx = a.x - b.x;
+	const double dy = a.y - b.y;
+	size_t i = 0;
+#if defined(__AVX2__)
+	const __m256d wide_dx = _mm256_set1_pd(dx);
+	const __m256d wide_dy = _mm256_set1_pd(dy);
+	const __m256d wide_bx = _mm256_set1_pd(b.x);
+	const __m256d wide_by = _mm256_set1_pd(b.y);
+	for (; i + 4 <= n; i += 4) {
+		const __m256d px = _mm256_loadu_pd(&xs[i]);
+		const __m256d py = _mm256_loadu_pd(&ys[i]);
+		_mm256_storeu_pd(&out[i],
+		                 _mm256_sub_pd(_mm256_mul_pd(wide_dx, _mm256_sub_pd(py, wide_by)),
+		                               _mm256_mul_pd(wide_dy, _mm256_sub_pd(px, wide_bx))));
+	}
+#elif defined(__SSE2__)
+	const __m128d wide_dx = _mm_set1_pd(dx);
+	const __m128d wide_dy = _mm_set1_pd(dy);
+	const __m128d wide_bx = _mm_set1_pd(b.x);
+	const __m128d wide_by = _mm_set1_pd(b.y);
+	for (; i + 2 <= n; i += 2) {
+		const __m128d px = _mm_loadu_pd(&xs[i]);
+		const __m128d py = _mm_loadu_pd(&ys[i]);
+		_mm_storeu_pd(&out[i], _mm_sub_pd(_mm_mul_pd(wide_dx, _mm_sub_pd(py, wide_by)),
+		                                  _mm_mul_pd(wide_dy, _mm_sub_pd(px, wide_bx))));
+	}
+#endif
+	for (; i < n; ++i) {
+		out[i] = dx * (ys[i] - b.y) - dy * (xs[i] - b.x);
+	}
+}
+
+/**
+ * @brief 128-bit integer, an extension of GCC and Clang
+ */
+__extension__ typedef __int128 int128;
+
+/**
+ * @brief Type in which squared distances and exact orientations of points with coordinates of type
+ * T are computed
+ * @details double for double coordinates, whose orientations are made exact by orientation(). The
+ * differences of integer coordinates take one bit more than the coordinates and their products
+ * twice as many, so the smallest signed integer type holding them is used, 64 bits for 16-bit
+ * coordinates and 128 bits for 32-bit ones. All values are then exact.
+ */
+template <typename T>
+using Wide =
+    conditional_t<is_floating_point_v<T>, double,
+                  conditional_t<(2 * numeric_limits<T>::digits + 4 <= 64), int64_t, int128>>;
+
+/**
+ * @brief Computes the square of the Euclidean distance between two points in the type Wide<T>
+ */
+template <typename T> Wide<T> distance_sq(const BasicPoint<T> &a, const BasicPoint<T> &b) {
+	const Wide<T> dx = Wide<T>(a.x) - b.x;
+	const Wide<T> dy = Wide<T>(a.y) - b.y;
+	return dx * dx + dy * dy;
+}
+
+/**
+ * @brief orientation() of points with integer coordinates, exact through the type Wide<T>
+ * @details 64-bit determinants are computed directly. 128-bit arithmetic costs more than a
+ * floating-point filter, so larger determinants are computed in double first, with the static
+ * error bound of Orientation<double>, and only nearly collinear points fall back to the integers.
+ * The differences of the coordinates are exact in double, so the filter is exact too.
+ */
+template <typename T> class Orientation {
+	static_assert(is_integral_v<T> && 2 * numeric_limits<T>::digits + 4 <= 128,
+	              "coordinates must be double or integers of at most 32 bits");
+
+	double bound = 0;
+
+  public:
+	explicit Orientation(const vector<BasicPoint<T>> &points) {
+		if constexpr (!is_same_v<Wide<T>, int64_t>) {
+			const auto [min_x, max_x] = minmax_element(
+			    points.begin(), points.end(),
+			    [](const BasicPoint<T> &a, const BasicPoint<T> &b) { return a.x < b.x; });
+			const auto [min_y, max_y] = minmax_element(
+			    points.begin(), points.end(),
+			    [](const BasicPoint<T> &a, const BasicPoint<T> &b) { return a.y < b.y; });
+			const auto width = static_cast<double>(int64_t{max_x->x} - min_x->x);
+			const auto height = static_cast<double>(int64_t{max_y->y} - min_y->y);
+			bound = 3 * ORIENTATION_ERROR * width * height;
+		}
+	}
+
+	/**
+	 * @returns a value with the sign of the exact orientation
+	 */
+	double operator()(const BasicPoint<T> &a, const BasicPoint<T> &b,
+	                  const BasicPoint<T> &c) const {
+		const int64_t ab_x = int64_t{a.x} - b.x;
+		const int64_t ab_y = int64_t{a.y} - b.y;
+		const int64_t cb_x = int64_t{c.x} - b.x;
+		const int64_t cb_y = int64_t{c.y} - b.y;
+		if constexpr (is_same_v<Wide<T>, int64_t>) {
+			return static_cast<double>(ab_x * cb_y - ab_y * cb_x);
+		} else {
+			const double det = static_cast<double>(ab_x) * static_cast<double>(cb_y) -
+			                   static_cast<double>(ab_y) * static_cast<double>(cb_x);
+			if (abs(det) > bound) return det;
+			return static_cast<double>(Wide<T>{ab_x} * cb_y - Wide<T>{ab_y} * cb_x);
+		}
+	}
+};
 
-	vector<pair<Point, size_t>> indexed_points;
+/**
+ * @brief orientation() with a static error bound for points within a bounding box
+ * @details The products of the coordinate differences of such points are bounded by the area of
+ * the box, so a value beyond the resulting bound has the correct sign and costs a single
+ * comparison. Only the remaining, nearly collinear points go through the adaptive orientation().
+ */
+template <> class Orientation<double> {
+	double bound = 0;
+
+  public:
+	explicit Orientation(const vector<Point> &points) {
+		const auto [min_x, max_x] = minmax_element(
+		    points.begin(), points.end(), [](const Point &a, const Point &b) { return a.x < b.x; });
+		const auto [min_y, max_y] = minmax_element(
+		    points.begin(), points.end(), [](const Point &a, const Point &b) { return a.y < b.y; });
+		// twice the area covers both products, the rest absorbs the rounding of the bound itself
+		bound = 3 * ORIENTATION_ERROR * (max_x->x - min_x->x) * (max_y->y - min_y->y);
+	}
+
+	double operator()(const Point &a, const Point &b, const Point &c) const {
+		const double det = (a.x - b.x) * (c.y - b.y) - (a.y - b.y) * (c.x - b.x);
+		return abs(det) > bound ? det : orientation(a, b, c);
+	}
+};
+
+/**
+ * @brief Computes a convex hull using the Graham's scan algorithm in O(nlogn)
+ * @param points at least two points
+ * @returns hull in the format of convex_hull()
+ */
+template <typename T> vector<size_t> graham_scan(const vector<BasicPoint<T>> &points) {
+	using IndexedPoint = pair<BasicPoint<T>, size_t>;
+	vector<IndexedPoint> indexed_points;
 	for (size_t i = 0; i < points.size(); ++i) {
 		indexed_points.emplace_back(points[i], i);
 	}
 
-	Point p0 = *min_element(points.begin(), points.end(), [](const Point &a, const Point &b) {
-		return a.y == b.y ? a.x < b.x : a.y < b.y;
-	});
+	BasicPoint<T> p0 = *min_element(
+	    points.begin(), points.end(), [](const BasicPoint<T> &a, const BasicPoint<T> &b) {
+		    return a.y == b.y ? a.x < b.x : a.y < b.y;
+	    });
 
+	const Orientation<T> orient(points);
 	sort(indexed_points.begin(), indexed_points.end(),
-	     [&p0](const pair<Point, size_t> &a, const pair<Point, size_t> &b) {
-		     const double o = orientation(p0, a.first, b.first);
+	     [&p0, &orient](const IndexedPoint &a, const IndexedPoint &b) {
+		     const double o = orient(p0, a.first, b.first);
 
 		     if (o == 0) {
-			     const double dist_a = distance_sq(p0, a.first);
-			     const double dist_b = distance_sq(p0, b.first);
-			     return dist_a < dist_b;
+			     const Wide<T> dist_a = distance_sq(p0, a.first);
+			     const Wide<T> dist_b = distance_sq(p0, b.first);
+			     return dist_a == dist_b ? a.second < b.second : dist_a < dist_b;
 		     }
 
 		     return o < 0;
 	     });
 
+	// duplicates are adjacent and ordered by index, only the first of them is kept
 	vector<size_t> hull;
 
-	for (const pair<Point, size_t> &p : indexed_points) {
+	for (const IndexedPoint &p : indexed_points) {
+		if (!hull.empty() && points[hull.back()] == p.first) continue;
 		while (hull.size() >= 2) {
-			const Point &p1 = points[hull[hull.size() - 2]];
-			const Point &p2 = points[hull[hull.size() - 1]];
+			const BasicPoint<T> &p1 = points[hull[hull.size() - 2]];
+			const BasicPoint<T> &p2 = points[hull[hull.size() - 1]];
 
-			if (orientation(p1, p2, p.first) < 0) break;
+			if (orient(p1, p2, p.first) < 0) break;
 			hull.pop_back();
 		}
 
@@ -94,6 +369,772 @@ std::vector<std::size_t> convex_hull(const std::vector<Point> &points) {
 	return hull;
 }
 
+/**
+ * @brief Maps a coordinate to an unsigned integer with the same order
+ * @details Flips the sign bit of non-negative IEEE-754 values and all bits of negative ones, so the
+ * resulting integers compare like the original values. -0.0 is mapped like 0.0.
+ */
+uint64_t order_key(double value) {
+	value += 0.0;
+	uint64_t bits = 0;
+	memcpy(&bits, &value, sizeof(bits));
+	return (bits >> 63U) != 0 ? ~bits : bits | (uint64_t{1} << 63U);
+}
+
+/**
+ * @brief Maps an integer coordinate to an unsigned integer with the same order
+ * @details Flips the sign bit of signed values, the key takes only as many bits as the coordinate.
+ */
+template <typename T, enable_if_t<is_integral_v<T>, int> = 0> uint64_t order_key(T value) {
+	using Unsigned = make_unsigned_t<T>;
+	constexpr unsigned SIGN_SHIFT = numeric_limits<Unsigned>::digits - 1;
+	constexpr auto SIGN = static_cast<Unsigned>(is_signed_v<T> ? Unsigned{1} << SIGN_SHIFT : 0);
+	return static_cast<Unsigned>(static_cast<Unsigned>(value) ^ SIGN);
+}
+
+/**
+ * @brief number of low bits of the keys of coordinates of type T which can differ
+ */
+template <typename T>
+constexpr unsigned KEY_BITS = is_integral_v<T> ? numeric_limits<T>::digits + is_signed_v<T> : 64;
+
+/**
+ * @brief Stable LSD radix sort of indices by keys of at most BITS bits
+ * @details Sorts 11 bits per pass. Histograms of all digits are counted in one pass over the keys
+ * and passes in which all keys share the digit are skipped.
+ * @param indices indices to sort
+ * @param keys key of every index, in the same order as indices, sorted along with them
+ */
+template <unsigned BITS> void radix_sort(vector<size_t> &indices, vector<uint64_t> &keys) {
+	constexpr unsigned RADIX_BITS = 11;
+	constexpr unsigned PASSES = (BITS + RADIX_BITS - 1) / RADIX_BITS;
+	constexpr size_t BUCKETS = size_t{1} << RADIX_BITS;
+
+	vector<size_t> histograms(PASSES * BUCKETS, 0);
+	for (const uint64_t key : keys) {
+		for (unsigned pass = 0; pass < PASSES; pass++) {
+			histograms[pass * BUCKETS + ((key >> (pass * RADIX_BITS)) & (BUCKETS - 1))]++;
+		}
+	}
+
+	const size_t n = indices.size();
+	vector<size_t> sorted_indices(n);
+	vector<uint64_t> sorted_keys(n);
+
+	for (unsigned pass = 0; pass < PASSES; pass++) {
+		const unsigned shift = pass * RADIX_BITS;
+		size_t *position = &histograms[pass * BUCKETS];
+		if (position[(keys[0] >> shift) & (BUCKETS - 1)] == n) continue;
+
+		size_t sum = 0;
+		for (size_t bucket = 0; bucket < BUCKETS; bucket++) {
+			sum += position[bucket];
+			position[bucket] = sum - position[bucket];
+		}
+		for (size_t i = 0; i < n; i++) {
+			const size_t j = position[(keys[i] >> shift) & (BUCKETS - 1)]++;
+			sorted_indices[j] = indices[i];
+			sorted_keys[j] = keys[i];
+		}
+		swap(indices, sorted_indices);
+		swap(keys, sorted_keys);
+	}
+}
+
+/**
+ * @brief Computes a convex hull using the Andrew's monotone chain algorithm
+ * @details Points are sorted by x coordinate with a radix sort over the bit patterns of the
+ * coordinates, so the whole algorithm runs in O(n) unless many points share the x coordinate.
+ * Integer coordinates of 32 bits need half as many passes of the radix sort as double ones.
+ * Points with equal x are then sorted by y. Small sets are sorted by comparison instead. Only the
+ * indices are sorted, the coordinates are read in sorted order once afterwards, so the chains are
+ * built with sequential memory accesses.
+ * @param points at least two points
+ * @returns hull in the format of convex_hull()
+ */
+template <typename T> vector<size_t> monotone_chain(const vector<BasicPoint<T>> &points) {
+	// below this size clearing the radix histograms costs more than a comparison sort
+	constexpr size_t RADIX_SORT_MIN = 1024;
+
+	const size_t n = points.size();
+	vector<size_t> order(n);
+	iota(order.begin(), order.end(), 0);
+	vector<BasicPoint<T>> sorted(n);
+
+	if (n < RADIX_SORT_MIN) {
+		sort(order.begin(), order.end(), [&points](size_t a, size_t b) {
+			return points[a] == points[b] ? a < b : points[a] < points[b];
+		});
+		for (size_t i = 0; i < n; ++i) {
+			sorted[i] = points[order[i]];
+		}
+	} else {
+		vector<uint64_t> keys(n);
+		for (size_t i = 0; i < n; ++i) {
+			keys[i] = order_key(points[i].x);
+		}
+		radix_sort<KEY_BITS<T>>(order, keys);
+
+		for (size_t i = 0; i < n; ++i) {
+			sorted[i] = points[order[i]];
+		}
+		for (size_t begin = 0, end = 0; begin < n; begin = end) {
+			while (end < n && keys[end] == keys[begin]) end++;
+			if (end - begin > 1) {
+				vector<pair<T, size_t>> run;
+				for (size_t i = begin; i < end; ++i) {
+					run.emplace_back(sorted[i].y, order[i]);
+				}
+				sort(run.begin(), run.end());
+				for (size_t i = begin; i < end; ++i) {
+					sorted[i].y = run[i - begin].first;
+					order[i] = run[i - begin].second;
+				}
+			}
+		}
+	}
+
+	// lower chain from the leftmost to the rightmost point, then upper chain back, both as
+	// positions in the sorted order, duplicates are skipped as they would form zero length edges
+	const Orientation<T> orient(sorted);
+	vector<size_t> hull;
+	const auto add = [&](size_t i, size_t chain_start) {
+		while (hull.size() >= chain_start + 2) {
+			const BasicPoint<T> &p1 = sorted[hull[hull.size() - 2]];
+			const BasicPoint<T> &p2 = sorted[hull[hull.size() - 1]];
+
+			if (orient(p1, p2, sorted[i]) < 0) break;
+			hull.pop_back();
+		}
+
+		hull.push_back(i);
+	};
+	for (size_t i = 0; i < n; ++i) {
+		if (i == 0 || sorted[i] != sorted[i - 1]) add(i, 0);
+	}
+	if (hull.size() == 1) return {order[hull[0]]};
+
+	const size_t upper_start = hull.size() - 1;
+	for (size_t i = hull.back(); i-- > 0;) {
+		if (i == 0 || sorted[i] != sorted[i - 1]) add(i, upper_start);
+	}
+	hull.pop_back();
+
+	const auto lowest = min_element(hull.begin(), hull.end(), [&sorted](size_t a, size_t b) {
+		const BasicPoint<T> &p = sorted[a];
+		const BasicPoint<T> &q = sorted[b];
+		return p.y == q.y ? p.x < q.x : p.y < q.y;
+	});
+	rotate(hull.begin(), lowest, hull.end());
+
+	for (size_t &i : hull) {
+		i = order[i];
+	}
+	return hull;
+}
+
+/**
+ * @brief Computes on which side of the line from p through a the point b lies
+ * @returns 1 if b is on the left, -1 if it is on the right and 0 if the points are collinear
+ */
+template <typename T>
+int turn(const Orientation<T> &orient, const BasicPoint<T> &p, const BasicPoint<T> &a,
+         const BasicPoint<T> &b) {
+	const double cross = orient(a, p, b);
+	return (cross > 0) - (cross < 0);
+}
+
+/**
+ * @brief Checks whether no neighbour of a vertex of a polygon lies to the right of the line from p
+ * through the vertex
+ */
+template <typename T>
+bool is_tangent(const Orientation<T> &orient, const BasicPoint<T> *polygon, size_t n,
+                const BasicPoint<T> &p, size_t c) {
+	return turn(orient, p, polygon[c], polygon[(c + n - 1) % n]) >= 0 &&
+	       turn(orient, p, polygon[c], polygon[(c + 1) % n]) >= 0;
+}
+
+/**
+ * @brief Finds the tangent from a point to a convex polygon
+ * @details Finds the vertex q such that no vertex of the polygon lies to the right of the line
+ * from p through q, the farther one if there are two. If p is a vertex of the polygon, its
+ * successor is returned. The edges with p strictly on their right form one run, which ends at q.
+ * An edge of the run and an edge outside of it are found with a binary search over the fan of
+ * triangles from the first vertex, then the end of the run with another binary search, in
+ * O(log n) for any p satisfying the precondition.
+ * @param orient orientation of the points
+ * @param polygon vertices of a convex polygon in counter-clockwise order without collinear ones
+ * @param n number of vertices
+ * @param p point outside of the polygon or one of its vertices
+ * @returns position of the tangent vertex in the polygon
+ */
+template <typename T>
+size_t tangent(const Orientation<T> &orient, const BasicPoint<T> *polygon, size_t n,
+               const BasicPoint<T> &p) {
+	if (n <= 2) {
+		const size_t other = n - 1;
+		if (polygon[0] == p) return 1 % n;
+		if (polygon[other] == p) return 0;
+		const int side = turn(orient, p, polygon[0], polygon[other]);
+		return side > 0 || (side == 0 && distance_sq(p, polygon[0]) >
+		                                     distance_sq(p, polygon[other]))
+		           ? 0
+		           : other;
+	}
+	if (polygon[0] == p) return 1;
+
+	const auto visible = [&](size_t i) {
+		return orient(polygon[i % n], polygon[(i + 1) % n], p) > 0;
+	};
+	// the last of the vertices from 1 to n - 2 such that p, or p reflected through the first
+	// vertex if sign is -1, is not on the right of the line from the first vertex through it
+	const auto sector = [&](double sign) {
+		size_t low = 1;
+		size_t high = n - 2;
+		while (low < high) {
+			const size_t mid = (low + high + 1) / 2;
+			if (sign * orient(polygon[0], polygon[mid], p) <= 0) {
+				low = mid;
+			} else {
+				high = mid - 1;
+			}
+		}
+		return low;
+	};
+
+	// the edge starting at low is visible and the one starting at high is not
+	size_t low = 0;
+	size_t high = 0;
+	const bool first = visible(0);
+	const bool last = visible(n - 1);
+	if (first && last) {
+		// p lies behind the first vertex, so its reflection lies inside the angle at it
+		high = sector(-1);
+	} else if (first) {
+		high = n - 1;
+	} else if (last) {
+		low = n - 1;
+		high = n;
+	} else {
+		low = sector(1);
+		high = n;
+		if (!visible(low)) {
+			// p lies in the triangle of the fan, so it is one of its vertices
+			assert(polygon[low] == p || polygon[low + 1] == p);
+			return polygon[low] == p ? low + 1 : (low + 2) % n;
+		}
+	}
+	while (high - low > 1) {
+		const size_t mid = (low + high) / 2;
+		if (visible(mid)) {
+			low = mid;
+		} else {
+			high = mid;
+		}
+	}
+
+	// the edge after the tangent vertex can lie on the tangent, its farther end is the hull vertex
+	size_t result = high % n;
+	if (turn(orient, p, polygon[result], polygon[(result + 1) % n]) == 0) {
+		result = (result + 1) % n;
+	}
+	assert(is_tangent(orient, polygon, n, p, result));
+	return result;
+}
+
+/**
+ * @brief Wraps the candidates with hulls of groups of m of them in O(k log m) for at most m steps
+ * @details Only vertices of the group hulls can be vertices of the hull, so if the hull has more
+ * than m vertices, the candidates are reduced to them for the next attempt. Duplicates of a point
+ * are represented by the one with the lowest index.
+ * @param points at least two points
+ * @param candidates indices of the points which can be vertices of the hull, in blocks of
+ * increasing indices, reduced if the hull is not found
+ * @param start index of the lowest point
+ * @param m size of the groups
+ * @param hull output, filled only if it has at most m vertices
+ * @returns whether the hull was found
+ */
+template <typename T>
+bool chan_wrap(const vector<BasicPoint<T>> &points, vector<size_t> &candidates, size_t start,
+               size_t m, vector<size_t> &hull) {
+	// vertices of the group hulls stored one after another, group g takes offsets[g]..offsets[g+1],
+	// the groups are small, so they are sorted by comparison and wrapped by the monotone chain here
+	const Orientation<T> orient(points);
+	vector<size_t> vertex_indexes;
+	vector<size_t> offsets = {0};
+	vector<pair<BasicPoint<T>, size_t>> group;
+	const auto add = [&](size_t i, size_t chain_start) {
+		while (vertex_indexes.size() >= chain_start + 2) {
+			const BasicPoint<T> &p1 = points[vertex_indexes[vertex_indexes.size() - 2]];
+			const BasicPoint<T> &p2 = points[vertex_indexes[vertex_indexes.size() - 1]];
+
+			if (orient(p1, p2, points[i]) < 0) break;
+			vertex_indexes.pop_back();
+		}
+
+		vertex_indexes.push_back(i);
+	};
+	for (size_t begin = 0; begin < candidates.size(); begin += m) {
+		const size_t end = min(candidates.size(), begin + m);
+		group.clear();
+		for (size_t i = begin; i < end; ++i) {
+			group.emplace_back(points[candidates[i]], candidates[i]);
+		}
+		sort(group.begin(), group.end());
+
+		const size_t lower_start = vertex_indexes.size();
+		size_t last = 0;
+		for (size_t i = 0; i < group.size(); ++i) {
+			if (i == 0 || group[i].first != group[i - 1].first) {
+				add(group[i].second, lower_start);
+				last = i;
+			}
+		}
+		if (vertex_indexes.size() - lower_start > 1) {
+			const size_t upper_start = vertex_indexes.size() - 1;
+			for (size_t i = last; i-- > 0;) {
+				if (i == 0 || group[i].first != group[i - 1].first) {
+					add(group[i].second, upper_start);
+				}
+			}
+			vertex_indexes.pop_back();
+		}
+		offsets.push_back(vertex_indexes.size());
+	}
+
+	vector<BasicPoint<T>> vertices(vertex_indexes.size());
+	for (size_t i = 0; i < vertex_indexes.size(); ++i) {
+		vertices[i] = points[vertex_indexes[i]];
+	}
+
+	hull = {start};
+	for (size_t step = 0; step < m; ++step) {
+		const BasicPoint<T> &p = points[hull.back()];
+		size_t best = points.size();
+		for (size_t g = 0; g + 1 < offsets.size(); ++g) {
+			const size_t size = offsets[g + 1] - offsets[g];
+			const size_t q =
+			    vertex_indexes[offsets[g] + tangent(orient, &vertices[offsets[g]], size, p)];
+			if (points[q] == p) continue;
+			if (best == points.size()) {
+				best = q;
+				continue;
+			}
+			// the most clockwise candidate, or the farthest one if they are collinear
+			const int side = turn(orient, p, points[best], points[q]);
+			if (side < 0 ||
+			    (side == 0 && distance_sq(p, points[q]) > distance_sq(p, points[best]))) {
+				best = q;
+			}
+		}
+
+		if (best == points.size() || points[best] == points[start]) return true;
+		hull.push_back(best);
+	}
+
+	candidates = move(vertex_indexes);
+	return false;
+}
+
+/**
+ * @brief Computes a convex hull using the Chan's algorithm in O(nlogh)
+ * @details Gift wrapping over hulls of groups of m points with tangents found by binary search,
+ * with m squared after every attempt which needs more than m steps. The first attempt uses groups
+ * of 256 points, wrapping smaller ones costs more than it saves.
+ * @param points at least two points
+ * @returns hull in the format of convex_hull()
+ */
+template <typename T> vector<size_t> chan(const vector<BasicPoint<T>> &points) {
+	const auto lowest = [](const BasicPoint<T> &a, const BasicPoint<T> &b) {
+		return a.y == b.y ? a.x < b.x : a.y < b.y;
+	};
+	const auto start =
+	    static_cast<size_t>(min_element(points.begin(), points.end(), lowest) - points.begin());
+
+	vector<size_t> candidates(points.size());
+	iota(candidates.begin(), candidates.end(), 0);
+	vector<size_t> hull;
+	for (size_t m = 256;; m = m < (size_t{1} << 32U) ? m * m : candidates.size()) {
+		m = min(m, candidates.size());
+		if (chan_wrap(points, candidates, start, m, hull)) return hull;
+	}
+}
+
+/**
+ * @brief Chooses an algorithm for the given points
+ * @details Computes the hull of an evenly spaced sample of the points. This is a heuristic: the
+ * sample hull can have more or fewer vertices than the full hull, but for typical inputs a small
+ * sample hull suggests a small full hull, for which the output-sensitive Chan's algorithm pays
+ * off. A wrong guess only costs time, both algorithms give the same hull.
+ */
+template <typename T> Algorithm choose_algorithm(const vector<BasicPoint<T>> &points) {
+	constexpr size_t SAMPLE = 1024;
+	constexpr size_t SMALL_HULL = 32;
+	if (points.size() <= 4 * SAMPLE) return Algorithm::monotone_chain;
+
+	vector<BasicPoint<T>> sample(SAMPLE);
+	for (size_t i = 0; i < SAMPLE; ++i) {
+		sample[i] = points[i * (points.size() / SAMPLE)];
+	}
+	return monotone_chain(sample).size() <= SMALL_HULL ? Algorithm::chan
+	                                                   : Algorithm::monotone_chain;
+}
+
+/**
+ * @brief Inner side of a directed edge b -> a of a counter-clockwise convex polygon
+ * @details A point p is strictly inside if `orientation(a, b, p)` exceeds margin, which bounds its
+ * rounding error for points within the bounding box of the input.
+ */
+struct HalfPlane {
+	Point a;
+	Point b;
+	double margin;
+};
+
+/**
+ * @brief Input points stored as pairs
+ */
+template <typename T> struct PairPoints {
+	using Coordinate = T;
+
+	const vector<BasicPoint<T>> &points;
+
+	size_t size() const { return points.size(); }
+	const BasicPoint<T> &operator[](size_t i) const { return points[i]; }
+	const vector<BasicPoint<T>> &pairs() const { return points; }
+
+	/**
+	 * @brief Gives the coordinates of n points starting from begin as separate arrays
+	 * @param xs buffer for n x coordinates
+	 * @param ys buffer for n y coordinates
+	 */
+	pair<const double *, const double *> coordinates(size_t begin, size_t n, double *xs,
+	                                                 double *ys) const {
+		for (size_t i = 0; i < n; ++i) {
+			xs[i] = static_cast<double>(points[begin + i].x);
+			ys[i] = static_cast<double>(points[begin + i].y);
+		}
+		return {xs, ys};
+	}
+};
+
+/**
+ * @brief Input points stored as separate arrays of coordinates
+ */
+struct SplitPoints {
+	using Coordinate = double;
+
+	const vector<double> &xs;
+	const vector<double> &ys;
+
+	size_t size() const { return xs.size(); }
+	Point operator[](size_t i) const { return {xs[i], ys[i]}; }
+	vector<Point> pairs() const {
+		vector<Point> points(xs.size());
+		for (size_t i = 0; i < xs.size(); ++i) {
+			points[i] = {xs[i], ys[i]};
+		}
+		return points;
+	}
+
+	pair<const double *, const double *> coordinates(size_t begin, size_t /*n*/, double * /*xs*/,
+	                                                 double * /*ys*/) const {
+		return {&xs[begin], &ys[begin]};
+	}
+};
+
+/**
+ * @brief Finds the Akl-Toussaint octagon
+ * @param points input points
+ * @param threads number of threads
+ * @param planes inner sides of the octagon edges
+ * @returns number of edges of the octagon, 0 if it is degenerate
+ */
+template <typename Points>
+size_t octagon(const Points &points, size_t threads, array<HalfPlane, 8> &planes) {
+	// counter-clockwise, so that the extreme points in these directions are in hull order
+	const array<Point, 8> directions = {
+	    {{0, -1}, {1, -1}, {1, 0}, {1, 1}, {0, 1}, {-1, 1}, {-1, 0}, {-1, -1}}};
+	const size_t chunks = (points.size() + PARALLEL_CHUNK - 1) / PARALLEL_CHUNK;
+	vector<array<size_t, 8>> chunk_extreme(chunks);
+	for_each_chunk(threads, points.size(), [&](size_t chunk, size_t begin, size_t end) {
+		array<size_t, 8> &extreme = chunk_extreme[chunk];
+		extreme.fill(begin);
+		array<double, 8> best{};
+		for (size_t k = 0; k < directions.size(); ++k) {
+			best[k] = directions[k].x * points[begin].x + directions[k].y * points[begin].y;
+		}
+		for (size_t i = begin + 1; i < end; ++i) {
+			const Point p = points[i];
+			for (size_t k = 0; k < directions.size(); ++k) {
+				const double value = directions[k].x * p.x + directions[k].y * p.y;
+				if (value > best[k]) {
+					best[k] = value;
+					extreme[k] = i;
+				}
+			}
+		}
+	});
+
+	// the first of equally extreme points wins, as in a sequential scan
+	array<size_t, 8> extreme = chunk_extreme[0];
+	for (size_t chunk = 1; chunk < chunks; ++chunk) {
+		for (size_t k = 0; k < directions.size(); ++k) {
+			const Point &d = directions[k];
+			const Point p = points[chunk_extreme[chunk][k]];
+			const Point q = points[extreme[k]];
+			if (d.x * p.x + d.y * p.y > d.x * q.x + d.y * q.y) extreme[k] = chunk_extreme[chunk][k];
+		}
+	}
+
+	vector<Point> polygon;
+	for (const size_t i : extreme) {
+		const Point p = points[i];
+		if (polygon.empty() || p != polygon.back()) polygon.push_back(p);
+	}
+	while (polygon.size() > 1 && polygon.back() == polygon.front()) {
+		polygon.pop_back();
+	}
+	if (polygon.size() < 3) return 0;
+
+	const double width = Point(points[extreme[2]]).x - Point(points[extreme[6]]).x;
+	const double height = Point(points[extreme[4]]).y - Point(points[extreme[0]]).y;
+	const double error = 8 * numeric_limits<double>::epsilon();
+	for (size_t k = 0; k < polygon.size(); ++k) {
+		const Point &a = polygon[(k + 1) % polygon.size()];
+		const Point &b = polygon[k];
+		planes[k] = {a, b, error * (abs(a.x - b.x) * height + abs(a.y - b.y) * width)};
+	}
+	return polygon.size();
+}
+
+/**
+ * @brief Appends indexes of points from `[begin, end)` which are not strictly inside a polygon
+ * @details The points are processed in blocks small enough to stay in the L1 cache, each block is
+ * tested against one edge at a time with orientation_batch().
+ * @param points input points
+ * @param planes inner sides of the polygon edges
+ * @param edges number of edges of the polygon
+ * @param begin first point to test
+ * @param end end of the range of points to test
+ * @param kept output
+ */
+template <typename Points>
+void keep_outside(const Points &points, const array<HalfPlane, 8> &planes, size_t edges,
+                  size_t begin, size_t end, vector<size_t> &kept) {
+	constexpr size_t BLOCK = 256;
+	array<double, BLOCK> x_buffer{};
+	array<double, BLOCK> y_buffer{};
+	array<double, BLOCK> side{};
+	// smallest orientation minus margin over the edges processed so far, positive inside
+	array<double, BLOCK> slack{};
+
+	for (size_t block = begin; block < end; block += BLOCK) {
+		const size_t n = min(BLOCK, end - block);
+		const auto coordinates = points.coordinates(block, n, x_buffer.data(), y_buffer.data());
+
+		slack.fill(numeric_limits<double>::infinity());
+		for (size_t k = 0; k < edges; ++k) {
+			orientation_batch(planes[k].a, planes[k].b, coordinates.first, coordinates.second, n,
+			                  side.data());
+			// whole blocks, so that the loop has a constant trip count and gets vectorized
+			for (size_t i = 0; i < BLOCK; ++i) {
+				const double s = side[i] - planes[k].margin;
+				slack[i] = s < slack[i] ? s : slack[i];
+			}
+		}
+		for (size_t i = 0; i < n; ++i) {
+			if (!(slack[i] > 0)) kept.push_back(block + i);
+		}
+	}
+}
+
+/**
+ * @brief Akl-Toussaint heuristic, discards points strictly inside the octagon of extreme points
+ * @param points input points
+ * @param threads number of threads
+ * @returns indexes of points which can be vertices of the hull in increasing order
+ */
+template <typename Points> vector<size_t> akl_toussaint(const Points &points, size_t threads) {
+	const size_t n = points.size();
+	array<HalfPlane, 8> planes{};
+	const size_t edges = octagon(points, threads, planes);
+
+	vector<size_t> kept;
+	if (edges == 0) {
+		kept.resize(n);
+		iota(kept.begin(), kept.end(), 0);
+		return kept;
+	}
+
+	vector<vector<size_t>> chunk_kept((n + PARALLEL_CHUNK - 1) / PARALLEL_CHUNK);
+	for_each_chunk(threads, n, [&](size_t chunk, size_t begin, size_t end) {
+		keep_outside(points, planes, edges, begin, end, chunk_kept[chunk]);
+	});
+	for (const vector<size_t> &part : chunk_kept) {
+		kept.insert(kept.end(), part.begin(), part.end());
+	}
+	return kept;
+}
+
+/**
+ * @brief Computes a convex hull of chunks of points in parallel and then the hull of their
+ * vertices
+ * @details Inputs of at most one chunk are passed to the sequential algorithm directly. The chunks
+ * do not depend on the number of threads, so neither does the result.
+ * @param points at least two points
+ * @param threads number of threads
+ * @param run sequential algorithm
+ * @returns hull in the format of convex_hull()
+ */
+template <typename T, typename Engine>
+vector<size_t> parallel_hull(const vector<BasicPoint<T>> &points, size_t threads, Engine run) {
+	const size_t n = points.size();
+	if (n <= PARALLEL_CHUNK) return run(points);
+
+	vector<vector<size_t>> chunk_hull((n + PARALLEL_CHUNK - 1) / PARALLEL_CHUNK);
+	for_each_chunk(threads, n, [&](size_t chunk, size_t begin, size_t end) {
+		if (end - begin == 1) {
+			chunk_hull[chunk] = {begin};
+			return;
+		}
+		chunk_hull[chunk] =
+		    run(vector<BasicPoint<T>>(points.begin() + begin, points.begin() + end));
+		for (size_t &i : chunk_hull[chunk]) {
+			i += begin;
+		}
+	});
+
+	vector<size_t> vertices;
+	for (const vector<size_t> &part : chunk_hull) {
+		vertices.insert(vertices.end(), part.begin(), part.end());
+	}
+	vector<BasicPoint<T>> merged(vertices.size());
+	for (size_t i = 0; i < vertices.size(); ++i) {
+		merged[i] = points[vertices[i]];
+	}
+	vector<size_t> hull = run(merged);
+	for (size_t &i : hull) {
+		i = vertices[i];
+	}
+	return hull;
+}
+
+/**
+ * @returns fraction of the input points discarded by the prefilter
+ */
+double HullStats::discarded_fraction() const {
+	return points == 0 ? 0 : static_cast<double>(discarded) / static_cast<double>(points);
+}
+
+/**
+ * @brief Computes a convex hull of points in either layout, see convex_hull()
+ */
+template <typename Points>
+vector<size_t> hull_of(const Points &points, const HullOptions &options, HullStats *stats) {
+	using T = typename Points::Coordinate;
+	if (stats != nullptr) *stats = {points.size(), 0};
+	if (points.size() == 0) return {};
+	if (points.size() == 1) return {0};
+
+	const size_t threads = resolve_threads(options.threads);
+	const auto sequential = [&options](const vector<BasicPoint<T>> &input) {
+		Algorithm algorithm = options.algorithm;
+		if (algorithm == Algorithm::automatic) algorithm = choose_algorithm(input);
+
+		switch (algorithm) {
+		case Algorithm::monotone_chain:
+			return monotone_chain(input);
+		case Algorithm::chan:
+			return chan(input);
+		default:
+			return graham_scan(input);
+		}
+	};
+	// chunked even on one thread, so that the result does not depend on the number of threads
+	const auto run = [&](const vector<BasicPoint<T>> &input) {
+		return parallel_hull(input, threads, sequential);
+	};
+
+	if (!options.prefilter) return run(points.pairs());
+
+	const vector<size_t> kept = akl_toussaint(points, threads);
+	if (stats != nullptr) stats->discarded = points.size() - kept.size();
+	if (kept.size() == points.size()) return run(points.pairs());
+
+	vector<BasicPoint<T>> candidates(kept.size());
+	for (size_t i = 0; i < kept.size(); ++i) {
+		candidates[i] = points[kept[i]];
+	}
+	vector<size_t> hull = run(candidates);
+	for (size_t &i : hull) {
+		i = kept[i];
+	}
+	return hull;
+}
+
+/**
+ * @brief Computes a convex hull
+ * @details Computes a convex hull in O(nlogn) with the Graham's scan algorithm, in O(n) with the
+ * Andrew's monotone chain algorithm on radix sorted points or in O(nlogh) with the Chan's
+ * algorithm, depending on the options. Unless disabled, points strictly inside the octagon of
+ * extreme points are discarded in O(n) first.
+ * Both stages work on fixed-size chunks of points, in parallel with more than one thread, and the
+ * hull is computed from the vertices of the hulls of the chunks, so the result does not depend on
+ * the number of threads.
+ * Coordinates are double, std::int16_t or std::int32_t, others are rejected at compile time;
+ * integer orientations are computed exactly in 64 or 128-bit integers.
+ * @param points vector of pairs where first is x coordinate and second is y coordinate of a point
+ * @param options algorithm to use, whether to use the prefilter and number of threads
+ * @param stats optional instrumentation output, filled if not null
+ * @returns vector of input points indexes forming a convex hull in counter-clockwise order
+ * starting from the point with the lowest y coordinate (and the lowest x coordinate in case of a
+ * tie). The set of points is minimal, so if there are multiple points on the same line, only the
+ * endpoints are included. Of several points with the same coordinates, the one with the lowest
+ * index is included, whichever algorithm is used.
+ */
+template <typename T, typename>
+std::vector<std::size_t> convex_hull(const std::vector<BasicPoint<T>> &points,
+                                     const HullOptions &options, HullStats *stats) {
+	return hull_of(PairPoints<T>{points}, options, stats);
+}
+
+template std::vector<std::size_t> convex_hull(const std::vector<Point> &points,
+                                              const HullOptions &options, HullStats *stats);
+template std::vector<std::size_t> convex_hull(const std::vector<BasicPoint<int16_t>> &points,
+                                              const HullOptions &options, HullStats *stats);
+template std::vector<std::size_t> convex_hull(const std::vector<BasicPoint<int32_t>> &points,
+                                              const HullOptions &options, HullStats *stats);
+
+/**
+ * @brief Computes a convex hull of points with double coordinates, see the template above
+ * @details Not a template, so that the points can be given as a braced list.
+ */
+std::vector<std::size_t> convex_hull(const std::vector<Point> &points, const HullOptions &options,
+                                     HullStats *stats) {
+	return convex_hull<double>(points, options, stats);
+}
+
+/**
+ * @brief Computes a convex hull of points given as separate arrays of coordinates
+ * @details The prefilter reads the coordinates in place, only the points it keeps are copied into
+ * pairs for the hull algorithm.
+ * @param xs x coordinates of the points
+ * @param ys y coordinates of the points, as many as xs
+ * @param options algorithm to use, whether to use the prefilter and number of threads
+ * @param stats optional instrumentation output, filled if not null
+ * @returns hull in the format of convex_hull()
+ */
+std::vector<std::size_t> convex_hull(const std::vector<double> &xs, const std::vector<double> &ys,
+                                     const HullOptions &options, HullStats *stats) {
+	if (xs.size() != ys.size()) {
+		throw std::invalid_argument("x and y coordinates must have the same size");
+	}
+	return hull_of(SplitPoints{xs, ys}, options, stats);
+}
+
 #undef x
 #undef y
 
@@ -2,18 +2,104 @@
 #define CONVEX_HULL_HPP
 
 #include <cstddef>
+#include <cstdint>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
 namespace convex_hull {
 
-using Point = std::pair<double, double>;
+template <typename T> using BasicPoint = std::pair<T, T>;
+
+using Point = BasicPoint<double>;
+
+/**
+ * @brief algorithm used by convex_hull::convex_hull()
+ */
+enum class Algorithm {
+	/**
+	 * @brief Graham's scan, points are sorted by polar angle with a comparison sort
+	 */
+	graham,
+	/**
+	 * @brief Andrew's monotone chain, points are sorted by coordinates with a radix sort
+	 */
+	monotone_chain,
+	/**
+	 * @brief Chan's output-sensitive algorithm, O(n log h) for a hull with h vertices
+	 */
+	chan,
+	/**
+	 * @brief Chan's algorithm if the hull of a sample of the points is small, monotone chain
+	 * otherwise
+	 */
+	automatic
+};
+
+/**
+ * @brief options for convex_hull::convex_hull()
+ */
+struct HullOptions {
+	Algorithm algorithm = Algorithm::graham;
+	/**
+	 * @brief discard points strictly inside the octagon spanned by the points extreme in x, y,
+	 * x + y and x - y before running the algorithm (Akl-Toussaint heuristic)
+	 */
+	bool prefilter = true;
+	/**
+	 * @brief number of threads, 0 means all hardware threads
+	 */
+	std::size_t threads = 1;
+};
+
+/**
+ * @brief instrumentation output of convex_hull::convex_hull()
+ */
+struct HullStats {
+	/**
+	 * @brief number of input points
+	 */
+	std::size_t points = 0;
+	/**
+	 * @brief number of points discarded by the prefilter
+	 */
+	std::size_t discarded = 0;
+
+	double discarded_fraction() const;
+};
 
 double distance_sq(const Point &a, const Point &b);
 
 double orientation(const Point &a, const Point &b, const Point &c);
 
-std::vector<std::size_t> convex_hull(const std::vector<Point> &points);
+void orientation_batch(const Point &a, const Point &b, const double *xs, const double *ys,
+                       std::size_t n, double *out);
+
+/**
+ * @brief whether convex_hull() accepts points with coordinates of type T
+ */
+template <typename T>
+constexpr bool IS_HULL_COORDINATE = std::is_same_v<T, double> || std::is_same_v<T, std::int16_t> ||
+                                    std::is_same_v<T, std::int32_t>;
+
+std::vector<std::size_t> convex_hull(const std::vector<Point> &points,
+                                     const HullOptions &options = {}, HullStats *stats = nullptr);
+
+template <typename T, typename = std::enable_if_t<IS_HULL_COORDINATE<T>>>
+std::vector<std::size_t> convex_hull(const std::vector<BasicPoint<T>> &points,
+                                     const HullOptions &options = {}, HullStats *stats = nullptr);
+
+extern template std::vector<std::size_t> convex_hull(const std::vector<Point> &points,
+                                                     const HullOptions &options, HullStats *stats);
+extern template std::vector<std::size_t>
+convex_hull(const std::vector<BasicPoint<std::int16_t>> &points, const HullOptions &options,
+            HullStats *stats);
+extern template std::vector<std::size_t>
+convex_hull(const std::vector<BasicPoint<std::int32_t>> &points, const HullOptions &options,
+            HullStats *stats);
+
+std::vector<std::size_t> convex_hull(const std::vector<double> &xs, const std::vector<double> &ys,
+                                     const HullOptions &options = {}, HullStats *stats = nullptr);
 
 }
 
@@ -0,0 +1,110 @@
+#include "dynamic_hull.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "convex_hull.hpp"
+
+namespace convex_hull {
+
+using namespace std;
+
+// NOLINTBEGIN(cppcoreguidelines-macro-usage)
+#define x first
+#define y second
+// NOLINTEND(cppcoreguidelines-macro-usage)
+
+/**
+ * @brief Inserts a point into a strictly concave chain
+ * @details The point is dropped if it lies on or below the chain. Otherwise it replaces the vertex
+ * with the same x coordinate, if any, and its neighbours are removed while they lie on or below the
+ * segments joining the point with their other neighbours.
+ * @param chain upper chain
+ * @param point point to insert
+ * @param index index reported for the point
+ * @returns whether the point became a vertex of the chain
+ */
+bool DynamicHull::insert(Chain &chain, const Point &point, size_t index) {
+	const auto vertex = [](Chain::const_iterator it) { return Point(it->x, it->y.first); };
+
+	auto after = chain.lower_bound(point.x);
+	if (after != chain.end() && after->x == point.x) {
+		if (point.y <= after->y.first) return false;
+		after = chain.erase(after);
+	} else if (after != chain.end() && after != chain.begin() &&
+	           orientation(vertex(prev(after)), point, vertex(after)) <= 0) {
+		return false;
+	}
+
+	const auto it = chain.emplace_hint(after, point.x, make_pair(point.y, index));
+	while (after != chain.end() && next(after) != chain.end() &&
+	       orientation(point, vertex(after), vertex(next(after))) <= 0) {
+		after = chain.erase(after);
+	}
+	while (it != chain.begin() && prev(it) != chain.begin() &&
+	       orientation(vertex(prev(prev(it))), vertex(prev(it)), point) <= 0) {
+		chain.erase(prev(it));
+	}
+	return true;
+}
+
+/**
+ * @brief Adds a point to the set in amortized O(log n)
+ * @details Of several points with the same coordinates, the one inserted first is reported.
+ * @param point point to add
+ * @param index index reported for the point by hull(), usually its position in the input
+ * @returns whether the point became a vertex of the hull
+ */
+bool DynamicHull::insert(const Point &point, size_t index) {
+	++points;
+	const bool in_upper = insert(upper, point, index);
+	const bool in_lower = insert(lower, {-point.x, -point.y}, index);
+	return in_upper || in_lower;
+}
+
+/**
+ * @returns number of inserted points
+ */
+size_t DynamicHull::size() const {
+	return points;
+}
+
+/**
+ * @brief Lists the vertices of the hull in O(h)
+ * @returns hull of the inserted points in the format of convex_hull()
+ */
+vector<size_t> DynamicHull::hull() const {
+	if (points == 0) return {};
+
+	// both chains listed from right to left of their own orientation give the counter-clockwise
+	// order, the lower one starting from its leftmost point
+	vector<pair<Point, size_t>> vertices;
+	for (auto it = lower.rbegin(); it != lower.rend(); ++it) {
+		vertices.emplace_back(Point(-it->x, -it->y.first), it->y.second);
+	}
+	for (auto it = upper.rbegin(); it != upper.rend(); ++it) {
+		const Point point(it->x, it->y.first);
+		if (point != vertices.back().first && point != vertices.front().first) {
+			vertices.emplace_back(point, it->y.second);
+		}
+	}
+
+	const auto lowest = min_element(vertices.begin(), vertices.end(),
+	                                [](const pair<Point, size_t> &a, const pair<Point, size_t> &b) {
+		                                const Point &p = a.first;
+		                                const Point &q = b.first;
+		                                return p.y == q.y ? p.x < q.x : p.y < q.y;
+	                                });
+	rotate(vertices.begin(), lowest, vertices.end());
+
+	vector<size_t> hull;
+	for (const auto &vertex : vertices) {
+		hull.push_back(vertex.second);
+	}
+	return hull;
+}
+
+}
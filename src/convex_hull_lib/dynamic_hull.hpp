@@ -0,0 +1,47 @@
+#ifndef DYNAMIC_HULL_HPP
+#define DYNAMIC_HULL_HPP
+
+#include <cstddef>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "convex_hull.hpp"
+
+namespace convex_hull {
+
+/**
+ * @brief Convex hull of a set of points which grows one point at a time
+ * @details The upper and lower chains of the hull are kept in ordered maps keyed by x coordinate.
+ * An insertion finds the position of the point in O(log n) and removes the vertices it hides,
+ * every point is removed at most once, so insertions take amortized O(log n) time.
+ */
+class DynamicHull {
+  public:
+	bool insert(const Point &point, std::size_t index);
+
+	std::size_t size() const;
+	std::vector<std::size_t> hull() const;
+
+  private:
+	/**
+	 * @brief strictly concave chain as a map from x coordinate to y coordinate and index
+	 */
+	using Chain = std::map<double, std::pair<double, std::size_t>>;
+
+	/**
+	 * @brief upper chain of the points
+	 */
+	Chain upper;
+	/**
+	 * @brief upper chain of the points reflected through the origin, the lower chain
+	 */
+	Chain lower;
+	std::size_t points = 0;
+
+	static bool insert(Chain &chain, const Point &point, std::size_t index);
+};
+
+}
+
+#endif
@@ -0,0 +1,275 @@
+#include "hull_index.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "convex_hull.hpp"
+#include "parallel_chunks.hpp"
+
+namespace convex_hull {
+
+using namespace std;
+
+// NOLINTBEGIN(cppcoreguidelines-macro-usage)
+#define x first
+#define y second
+// NOLINTEND(cppcoreguidelines-macro-usage)
+
+/**
+ * @brief Computes on which side of the line from a through b the point c lies
+ * @returns positive if c is on the left, negative if it is on the right and zero if the points are
+ * collinear, the sign is exact like the one of orientation()
+ */
+double left_side(const Point &a, const Point &b, const Point &c) {
+	return -orientation(a, b, c);
+}
+
+/**
+ * @brief Compares two directions by their angle from the positive x axis in `[0, 2pi)`
+ */
+bool angle_less(const Point &u, const Point &v) {
+	const bool u_lower = u.y < 0 || (u.y == 0 && u.x < 0);
+	const bool v_lower = v.y < 0 || (v.y == 0 && v.x < 0);
+	if (u_lower != v_lower) return v_lower;
+	return u.x * v.y - u.y * v.x > 0;
+}
+
+/**
+ * @param points input points
+ * @param hull indexes of the hull vertices in the format of convex_hull()
+ */
+HullIndex::HullIndex(const vector<Point> &points, const vector<size_t> &hull) : indexes(hull) {
+	vertices.reserve(hull.size());
+	for (const size_t i : hull) {
+		if (i >= points.size()) throw out_of_range("hull index out of range");
+		vertices.push_back(points[i]);
+	}
+}
+
+/**
+ * @returns number of vertices of the hull
+ */
+size_t HullIndex::size() const {
+	return vertices.size();
+}
+
+/**
+ * @brief Finds the triangle of the fan from the first vertex which contains the point
+ * @details The directions from the first vertex to the others turn counter-clockwise by less than
+ * a half turn, so the triangle is found by binary search.
+ * @param point point within the angle at the first vertex, or the opposite angle if reflected
+ * @param reflected whether to locate the direction from the point to the first vertex instead
+ * @returns largest k in `[1, size() - 2]` such that the point is not on the right of the line from
+ * the first vertex through the vertex k, or not on the left if reflected
+ */
+size_t HullIndex::sector(const Point &point, bool reflected) const {
+	size_t low = 1;
+	size_t high = vertices.size() - 2;
+	while (low < high) {
+		const size_t middle = (low + high + 1) / 2;
+		const double side = left_side(vertices[0], vertices[middle], point);
+		if (reflected ? side <= 0 : side >= 0) {
+			low = middle;
+		} else {
+			high = middle - 1;
+		}
+	}
+	return low;
+}
+
+/**
+ * @brief Finds where the visibility of the edges from an outside point changes
+ * @details An edge is visible if the point lies strictly on its right. Visible edges form one
+ * contiguous run, so between a visible and a hidden edge it changes only once.
+ * @param from edge with the given visibility
+ * @param to edge with the opposite visibility
+ * @param point point outside of the hull
+ * @param visible visibility of the edge from
+ * @returns the first edge after from, counter-clockwise, whose visibility differs
+ */
+size_t HullIndex::visibility_change(size_t from, size_t to, const Point &point,
+                                    bool visible) const {
+	const size_t n = vertices.size();
+	size_t low = 1;
+	size_t high = (to + n - from) % n;
+	while (low < high) {
+		const size_t middle = (low + high) / 2;
+		const size_t edge = (from + middle) % n;
+		if ((left_side(vertices[edge], vertices[(edge + 1) % n], point) < 0) == visible) {
+			low = middle + 1;
+		} else {
+			high = middle;
+		}
+	}
+	return (from + low) % n;
+}
+
+/**
+ * @brief Tests whether a point lies inside the hull or on its boundary in O(log h)
+ * @param point point to test
+ * @returns whether the point is inside the hull or on its boundary
+ */
+bool HullIndex::contains(const Point &point) const {
+	const size_t n = vertices.size();
+	if (n == 0) return false;
+	if (n == 1) return point == vertices[0];
+
+	const Point &first = vertices[0];
+	if (n == 2) {
+		const Point &second = vertices[1];
+		return left_side(first, second, point) == 0 && min(first, second) <= point &&
+		       point <= max(first, second);
+	}
+	if (left_side(first, vertices[1], point) < 0 || left_side(vertices[n - 1], first, point) < 0) {
+		return false;
+	}
+	const size_t k = sector(point, false);
+	return left_side(vertices[k], vertices[k + 1], point) >= 0;
+}
+
+/**
+ * @brief Finds the vertex of the hull extreme in a direction in O(log h)
+ * @details The directions of the edges increase in angle from the first vertex, the lowest one.
+ * The extreme vertex is the first one whose outgoing edge turns at least a right angle
+ * counter-clockwise from the direction, so of two equally extreme vertices the one where the edge
+ * between them starts is returned.
+ * @param direction direction of the extreme, not necessarily of unit length
+ * @returns input index of the vertex with the largest dot product with the direction
+ */
+size_t HullIndex::extreme(const Point &direction) const {
+	const size_t n = vertices.size();
+	if (n == 0) throw out_of_range("hull is empty");
+
+	const Point normal(-direction.y, direction.x);
+	size_t low = 0;
+	size_t high = n;
+	while (low < high) {
+		const size_t middle = (low + high) / 2;
+		const Point &a = vertices[middle];
+		const Point &b = vertices[(middle + 1) % n];
+		if (angle_less({b.x - a.x, b.y - a.y}, normal)) {
+			low = middle + 1;
+		} else {
+			high = middle;
+		}
+	}
+	return indexes[low % n];
+}
+
+/**
+ * @brief Finds the tangents from a point outside of the hull in O(log h)
+ * @details The edges visible from the point form a chain between the two tangent vertices. A
+ * visible and a hidden edge are found with the fan from the first vertex, the ends of the chain by
+ * binary search between them. If an edge lies on a tangent, its vertex nearer to the point is
+ * returned.
+ * @param point point to draw the tangents from
+ * @returns input indexes of the tangent vertices, first the one with the hull on the right of the
+ * ray from the point through it, then the one with the hull on the left, none if the point is
+ * inside the hull or on its boundary
+ */
+optional<HullIndex::Tangents> HullIndex::tangents(const Point &point) const {
+	const size_t n = vertices.size();
+	if (n == 0 || contains(point)) return nullopt;
+	if (n == 1) return Tangents{indexes[0], indexes[0]};
+
+	const Point &first = vertices[0];
+	size_t visible = 0;
+	size_t hidden = 0;
+	if (n == 2) {
+		const double side = left_side(first, vertices[1], point);
+		if (side == 0) {
+			const size_t nearer =
+			    distance_sq(point, vertices[1]) < distance_sq(point, first) ? 1 : 0;
+			return Tangents{indexes[nearer], indexes[nearer]};
+		}
+		visible = side < 0 ? 0 : 1;
+		hidden = 1 - visible;
+	} else {
+		const double after_first = left_side(first, vertices[1], point);
+		const double before_first = left_side(vertices[n - 1], first, point);
+		if (after_first >= 0 && before_first >= 0) {
+			// within the angle at the first vertex, beyond the edge closing the fan triangle
+			visible = sector(point, false);
+			hidden = 0;
+		} else if (after_first < 0 && before_first < 0) {
+			// the ray from the point through the first vertex leaves the hull through a hidden edge
+			visible = 0;
+			hidden = sector(point, true);
+		} else {
+			visible = after_first < 0 ? 0 : n - 1;
+			hidden = after_first < 0 ? n - 1 : 0;
+		}
+	}
+
+	const size_t first_hidden = visibility_change(visible, hidden, point, true);
+	const size_t first_visible = visibility_change(hidden, visible, point, false);
+	return Tangents{indexes[first_visible], indexes[first_hidden]};
+}
+
+/**
+ * @brief Runs contains() for many points
+ * @param queries points to test
+ * @param threads number of threads, 0 means all hardware threads
+ * @returns indexes of the queries inside the hull or on its boundary in increasing order
+ */
+vector<size_t> HullIndex::inside(const vector<Point> &queries, size_t threads) const {
+	vector<vector<size_t>> chunk_inside((queries.size() + PARALLEL_CHUNK - 1) / PARALLEL_CHUNK);
+	for_each_chunk(resolve_threads(threads), queries.size(),
+	               [&](size_t chunk, size_t begin, size_t end) {
+		               for (size_t i = begin; i < end; ++i) {
+			               if (contains(queries[i])) chunk_inside[chunk].push_back(i);
+		               }
+	               });
+
+	vector<size_t> result;
+	for (const vector<size_t> &part : chunk_inside) {
+		result.insert(result.end(), part.begin(), part.end());
+	}
+	return result;
+}
+
+/**
+ * @brief Runs extreme() for many directions
+ * @param directions directions of the extremes
+ * @param threads number of threads, 0 means all hardware threads
+ * @returns input index of the extreme vertex for every direction
+ */
+vector<size_t> HullIndex::extreme(const vector<Point> &directions, size_t threads) const {
+	if (vertices.empty() && !directions.empty()) throw out_of_range("hull is empty");
+
+	vector<size_t> result(directions.size());
+	for_each_chunk(resolve_threads(threads), directions.size(),
+	               [&](size_t /*chunk*/, size_t begin, size_t end) {
+		               for (size_t i = begin; i < end; ++i) {
+			               result[i] = extreme(directions[i]);
+		               }
+	               });
+	return result;
+}
+
+/**
+ * @brief Runs tangents() for many points
+ * @param queries points to draw the tangents from
+ * @param threads number of threads, 0 means all hardware threads
+ * @returns tangent vertices for every query
+ */
+vector<optional<HullIndex::Tangents>> HullIndex::tangents(const vector<Point> &queries,
+                                                          size_t threads) const {
+	vector<optional<Tangents>> result(queries.size());
+	for_each_chunk(resolve_threads(threads), queries.size(),
+	               [&](size_t /*chunk*/, size_t begin, size_t end) {
+		               for (size_t i = begin; i < end; ++i) {
+			               result[i] = tangents(queries[i]);
+		               }
+	               });
+	return result;
+}
+
+#undef x
+#undef y
+
+}
@@ -0,0 +1,55 @@
+#ifndef HULL_INDEX_HPP
+#define HULL_INDEX_HPP
+
+#include <cstddef>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "convex_hull.hpp"
+
+namespace convex_hull {
+
+/**
+ * @brief Queries against a computed convex hull in O(log h) for a hull with h vertices
+ * @details Keeps the hull vertices in counter-clockwise order. Their directions from the first
+ * vertex and the directions of the edges are both sorted by angle, so point location, extreme
+ * points and tangents are found by binary search.
+ */
+class HullIndex {
+  public:
+	using Tangents = std::pair<std::size_t, std::size_t>;
+
+	HullIndex(const std::vector<Point> &points, const std::vector<std::size_t> &hull);
+
+	std::size_t size() const;
+
+	bool contains(const Point &point) const;
+	std::size_t extreme(const Point &direction) const;
+	std::optional<Tangents> tangents(const Point &point) const;
+
+	std::vector<std::size_t> inside(const std::vector<Point> &queries,
+	                                std::size_t threads = 1) const;
+	std::vector<std::size_t> extreme(const std::vector<Point> &directions,
+	                                 std::size_t threads = 1) const;
+	std::vector<std::optional<Tangents>> tangents(const std::vector<Point> &queries,
+	                                              std::size_t threads = 1) const;
+
+  private:
+	/**
+	 * @brief coordinates of the hull vertices in counter-clockwise order
+	 */
+	std::vector<Point> vertices;
+	/**
+	 * @brief input index of every vertex
+	 */
+	std::vector<std::size_t> indexes;
+
+	std::size_t sector(const Point &point, bool reflected) const;
+	std::size_t visibility_change(std::size_t from, std::size_t to, const Point &point,
+	                              bool visible) const;
+};
+
+}
+
+#endif
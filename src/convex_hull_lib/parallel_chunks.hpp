@@ -0,0 +1,48 @@
+#ifndef PARALLEL_CHUNKS_HPP
+#define PARALLEL_CHUNKS_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include "../bipartite_maximum_matching_lib/parallel_for.hpp"
+
+namespace convex_hull {
+
+/**
+ * @brief number of points processed as one unit of work in parallel stages
+ */
+constexpr std::size_t PARALLEL_CHUNK = std::size_t{1} << 16U;
+
+using bipartite_maximum_matching::resolve_threads;
+
+/**
+ * @brief Runs `fn(chunk, begin, end)` for consecutive chunks of `[0, n)` on the given number of
+ * threads
+ * @details Chunks have a fixed size, so the work done for every chunk and the results do not
+ * depend on the number of threads.
+ */
+template <typename Function> void for_each_chunk(std::size_t threads, std::size_t n, Function fn) {
+	const std::size_t chunks = (n + PARALLEL_CHUNK - 1) / PARALLEL_CHUNK;
+	std::atomic<std::size_t> next{0};
+	const auto worker = [&]() {
+		for (std::size_t chunk = next++; chunk < chunks; chunk = next++) {
+			fn(chunk, chunk * PARALLEL_CHUNK, std::min(n, (chunk + 1) * PARALLEL_CHUNK));
+		}
+	};
+
+	std::vector<std::thread> pool;
+	for (std::size_t t = 1; t < std::min(threads, chunks); ++t) {
+		pool.emplace_back(worker);
+	}
+	worker();
+	for (std::thread &t : pool) {
+		t.join();
+	}
+}
+
+}
+
+#endif
@@ -0,0 +1,177 @@
+#include "rotating_calipers.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "convex_hull.hpp"
+
+namespace convex_hull {
+
+using namespace std;
+
+// NOLINTBEGIN(cppcoreguidelines-macro-usage)
+#define x first
+#define y second
+// NOLINTEND(cppcoreguidelines-macro-usage)
+
+/**
+ * @brief Gathers the coordinates of the hull vertices, which must not be empty
+ */
+vector<Point> hull_vertices(const vector<Point> &points, const vector<size_t> &hull) {
+	if (hull.empty()) throw invalid_argument("hull is empty");
+
+	vector<Point> vertices;
+	vertices.reserve(hull.size());
+	for (const size_t i : hull) {
+		if (i >= points.size()) throw out_of_range("hull index out of range");
+		vertices.push_back(points[i]);
+	}
+	return vertices;
+}
+
+/**
+ * @returns twice the area of the triangle a, b, c, positive if it is counter-clockwise
+ */
+double twice_area(const Point &a, const Point &b, const Point &c) {
+	return -orientation(a, b, c);
+}
+
+/**
+ * @brief Rotates calipers around a convex polygon
+ * @details For every edge finds the vertex farthest from its line and the vertices extreme
+ * forward and backward along it. These follow the edge around the polygon counter-clockwise, so
+ * every one of them moves around the polygon at most twice and the rotation takes O(h). Of
+ * equally extreme vertices the first one is found.
+ * @param vertices vertices of a convex polygon in counter-clockwise order without collinear ones
+ * @param fn called as `fn(edge, far, front, back)` with positions of the vertices for every edge
+ * from the vertex `edge` to the next one
+ */
+template <typename Function> void rotate_calipers(const vector<Point> &vertices, Function fn) {
+	const size_t n = vertices.size();
+	const auto next = [n](size_t i) { return (i + 1) % n; };
+
+	size_t far = next(0);
+	size_t front = next(0);
+	size_t back = 0;
+	for (size_t i = 0; i < n; ++i) {
+		const Point &a = vertices[i];
+		const Point &b = vertices[next(i)];
+		const auto along = [&](size_t k) {
+			return (b.x - a.x) * (vertices[k].x - a.x) + (b.y - a.y) * (vertices[k].y - a.y);
+		};
+
+		while (twice_area(a, b, vertices[next(far)]) > twice_area(a, b, vertices[far])) {
+			far = next(far);
+		}
+		while (along(next(front)) > along(front)) {
+			front = next(front);
+		}
+		// the backward extreme follows the farthest vertex
+		if (i == 0) back = far;
+		while (along(next(back)) < along(back)) {
+			back = next(back);
+		}
+		fn(i, far, front, back);
+	}
+}
+
+/**
+ * @brief Computes the diameter of a convex hull in O(h)
+ * @details The farthest pair of vertices is a pair of vertices on parallel supporting lines, so
+ * only the ends of every edge and the vertex farthest from it are compared.
+ * @param points input points
+ * @param hull non-empty hull of the points in the format of convex_hull()
+ * @returns two vertices at the largest distance and the distance
+ */
+Diameter diameter(const vector<Point> &points, const vector<size_t> &hull) {
+	const vector<Point> vertices = hull_vertices(points, hull);
+	Diameter result{hull[0], hull[0], 0};
+	double best = 0;
+	rotate_calipers(vertices, [&](size_t edge, size_t far, size_t /*front*/, size_t /*back*/) {
+		for (const size_t end : {edge, (edge + 1) % vertices.size()}) {
+			const double distance = distance_sq(vertices[end], vertices[far]);
+			if (distance > best) {
+				best = distance;
+				result.first = hull[end];
+				result.second = hull[far];
+			}
+		}
+	});
+	result.distance = sqrt(best);
+	return result;
+}
+
+/**
+ * @brief Computes the width of a convex hull in O(h)
+ * @details The narrowest pair of parallel lines enclosing a convex polygon has an edge on one of
+ * them, so only the distance of every edge to the vertex farthest from it is considered.
+ * @param points input points
+ * @param hull non-empty hull of the points in the format of convex_hull()
+ * @returns the width and the edge and vertex on the enclosing lines
+ */
+Width width(const vector<Point> &points, const vector<size_t> &hull) {
+	const vector<Point> vertices = hull_vertices(points, hull);
+	if (vertices.size() == 1) return {hull[0], hull[0], hull[0], 0};
+
+	Width result{0, 0, 0, numeric_limits<double>::infinity()};
+	rotate_calipers(vertices, [&](size_t edge, size_t far, size_t /*front*/, size_t /*back*/) {
+		const size_t end = (edge + 1) % vertices.size();
+		const double distance = twice_area(vertices[edge], vertices[end], vertices[far]) /
+		                        sqrt(distance_sq(vertices[edge], vertices[end]));
+		if (distance < result.width) result = {hull[edge], hull[end], hull[far], distance};
+	});
+	return result;
+}
+
+/**
+ * @brief Computes the minimum-area rectangle enclosing a convex hull in O(h)
+ * @details A side of the smallest enclosing rectangle contains an edge of the hull (Freeman and
+ * Shapira), so the rectangle aligned with every edge is spanned by the vertices extreme along and
+ * across the edge.
+ * @param points input points
+ * @param hull non-empty hull of the points in the format of convex_hull()
+ * @returns the rectangle and its area, degenerate if the hull has less than three vertices
+ */
+BoundingRectangle min_area_rectangle(const vector<Point> &points, const vector<size_t> &hull) {
+	const vector<Point> vertices = hull_vertices(points, hull);
+	BoundingRectangle result;
+	if (vertices.size() == 1) {
+		result.corners.fill(vertices[0]);
+		return result;
+	}
+
+	result.area = numeric_limits<double>::infinity();
+	rotate_calipers(vertices, [&](size_t edge, size_t far, size_t front, size_t back) {
+		const Point &a = vertices[edge];
+		const Point &b = vertices[(edge + 1) % vertices.size()];
+		const Point direction(b.x - a.x, b.y - a.y);
+		const double length_sq = distance_sq(a, b);
+		const auto along = [&](const Point &p) {
+			return direction.x * (p.x - a.x) + direction.y * (p.y - a.y);
+		};
+
+		const double height = twice_area(a, b, vertices[far]);
+		const double area = (along(vertices[front]) - along(vertices[back])) * height / length_sq;
+		if (area >= result.area) return;
+
+		// corners as multiples of the edge and its normal pointing into the hull
+		const double low = along(vertices[back]) / length_sq;
+		const double high = along(vertices[front]) / length_sq;
+		const double across = height / length_sq;
+		const auto corner = [&](double s, double t) {
+			return Point(a.x + s * direction.x - t * direction.y,
+			             a.y + s * direction.y + t * direction.x);
+		};
+		result = {{corner(low, 0), corner(high, 0), corner(high, across), corner(low, across)},
+		          area};
+	});
+	return result;
+}
+
+#undef x
+#undef y
+
+}
@@ -0,0 +1,60 @@
+#ifndef ROTATING_CALIPERS_HPP
+#define ROTATING_CALIPERS_HPP
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include "convex_hull.hpp"
+
+namespace convex_hull {
+
+/**
+ * @brief pair of hull vertices at the largest distance
+ */
+struct Diameter {
+	/**
+	 * @brief input indexes of the vertices
+	 */
+	std::size_t first = 0;
+	std::size_t second = 0;
+	double distance = 0;
+};
+
+/**
+ * @brief smallest distance between two parallel lines enclosing the hull
+ */
+struct Width {
+	/**
+	 * @brief input indexes of the ends of the hull edge lying on one of the lines
+	 */
+	std::size_t edge_start = 0;
+	std::size_t edge_end = 0;
+	/**
+	 * @brief input index of a hull vertex lying on the other line
+	 */
+	std::size_t vertex = 0;
+	double width = 0;
+};
+
+/**
+ * @brief rectangle enclosing the hull
+ */
+struct BoundingRectangle {
+	/**
+	 * @brief corners in counter-clockwise order, the first two lie on the line of a hull edge
+	 */
+	std::array<Point, 4> corners{};
+	double area = 0;
+};
+
+Diameter diameter(const std::vector<Point> &points, const std::vector<std::size_t> &hull);
+
+Width width(const std::vector<Point> &points, const std::vector<std::size_t> &hull);
+
+BoundingRectangle min_area_rectangle(const std::vector<Point> &points,
+                                     const std::vector<std::size_t> &hull);
+
+}
+
+#endif
@@ -0,0 +1,85 @@
+#include "streaming_hull.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "convex_hull.hpp"
+
+namespace convex_hull {
+
+using namespace std;
+
+/**
+ * @param chunk_size number of points buffered before they are merged into the hull, at least 1
+ * @param options options of convex_hull() used for every merge
+ */
+StreamingHull::StreamingHull(size_t chunk_size, const HullOptions &options)
+    : chunk_size(max<size_t>(chunk_size, 1)), options(options) {
+	chunk.reserve(this->chunk_size);
+}
+
+/**
+ * @brief Adds the next point of the stream, merges the chunk in O(k log k) when it gets full
+ * @param point point with index equal to the number of points added before it
+ */
+void StreamingHull::add_point(const Point &point) {
+	chunk.push_back(point);
+	++points;
+	if (chunk.size() == chunk_size) merge();
+}
+
+/**
+ * @brief Merges the points added since the last merge, call before reading the hull
+ */
+void StreamingHull::finish() {
+	if (!chunk.empty()) merge();
+}
+
+/**
+ * @brief Replaces the hull with the hull of its vertices and the buffered chunk
+ * @details The hull vertices come first and have lower indexes than the chunk points, so of
+ * several points with the same coordinates the one added first is kept, like in convex_hull()
+ * with any algorithm.
+ */
+void StreamingHull::merge() {
+	const size_t first_chunk_index = points - chunk.size();
+	const size_t old_size = hull_vertices.size();
+	hull_vertices.insert(hull_vertices.end(), chunk.begin(), chunk.end());
+	chunk.clear();
+
+	const vector<size_t> merged = convex_hull(hull_vertices, options);
+	vector<size_t> indexes(merged.size());
+	vector<Point> vertices(merged.size());
+	for (size_t i = 0; i < merged.size(); ++i) {
+		indexes[i] = merged[i] < old_size ? hull_indexes[merged[i]]
+		                                  : first_chunk_index + (merged[i] - old_size);
+		vertices[i] = hull_vertices[merged[i]];
+	}
+	hull_indexes = move(indexes);
+	hull_vertices = move(vertices);
+}
+
+/**
+ * @returns number of points added
+ */
+size_t StreamingHull::size() const {
+	return points;
+}
+
+/**
+ * @returns hull of the points added before the last call of finish() in the format of
+ * convex_hull()
+ */
+const vector<size_t> &StreamingHull::hull() const {
+	return hull_indexes;
+}
+
+/**
+ * @returns coordinates of the points listed by hull(), in the same order
+ */
+const vector<Point> &StreamingHull::vertices() const {
+	return hull_vertices;
+}
+
+}
@@ -0,0 +1,53 @@
+#ifndef STREAMING_HULL_HPP
+#define STREAMING_HULL_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include "convex_hull.hpp"
+
+namespace convex_hull {
+
+/**
+ * @brief Convex hull of points read as a stream, for inputs which do not fit in memory
+ * @details Points are buffered in chunks of fixed size. A full chunk is merged with the hull of the
+ * points before it by computing the hull of the chunk together with the current hull vertices,
+ * so only the hull and one chunk are kept in memory. Points are indexed in the order of arrival.
+ */
+class StreamingHull {
+  public:
+	static constexpr std::size_t DEFAULT_CHUNK = std::size_t{1} << 20U;
+
+	explicit StreamingHull(std::size_t chunk_size = DEFAULT_CHUNK, const HullOptions &options = {});
+
+	void add_point(const Point &point);
+	void finish();
+
+	std::size_t size() const;
+	const std::vector<std::size_t> &hull() const;
+	const std::vector<Point> &vertices() const;
+
+  private:
+	std::size_t chunk_size;
+	HullOptions options;
+	std::size_t points = 0;
+
+	/**
+	 * @brief points added since the last merge, the first one has index `points - chunk.size()`
+	 */
+	std::vector<Point> chunk;
+	/**
+	 * @brief indexes of the hull vertices of the merged points, in the format of convex_hull()
+	 */
+	std::vector<std::size_t> hull_indexes;
+	/**
+	 * @brief coordinates of the vertices in hull_indexes
+	 */
+	std::vector<Point> hull_vertices;
+
+	void merge();
+};
+
+}
+
+#endif
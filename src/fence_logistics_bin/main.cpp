@@ -1,3 +1,4 @@
+#include <cctype>
 #include <cmath>
 #include <cstddef>
 #include <cstring>
@@ -9,6 +10,7 @@
 #include <vector>
 
 #include "../convex_hull_lib/convex_hull.hpp"
+#include "../convex_hull_lib/streaming_hull.hpp"
 #include "../sssp_plane_lib/sssp_plane.hpp"
 
 using namespace std;
@@ -19,6 +21,34 @@ double euclidean_distance(const pair<double, double> &a, const pair<double, doub
 	return sqrt(dx * dx + dy * dy);
 }
 
+double polygon_perimeter(const vector<pair<double, double>> &vertices) {
+	double perimeter = 0;
+	for (size_t i = 0; i < vertices.size(); i++) {
+		perimeter += euclidean_distance(vertices[i], vertices[(i + 1) % vertices.size()]);
+	}
+	return perimeter;
+}
+
+void print_fence(ostream &out, bool verbose, double length, const vector<size_t> &fence) {
+	if (verbose) {
+		out << "Fence length: " << length << '\n';
+		out << "Fence:";
+		for (const auto &point : fence) {
+			out << ' ' << point + 1;
+		}
+		out << '\n';
+	} else {
+		out << length << '\n';
+		if (!fence.empty()) {
+			out << fence.front() + 1;
+		}
+		for (size_t i = 1; i < fence.size(); i++) {
+			out << ' ' << fence[i] + 1;
+		}
+		out << '\n';
+	}
+}
+
 int main(int argc, char *argv[]) {
 	istream *instream = nullptr;
 	ostream *outstream = nullptr;
@@ -28,10 +58,25 @@ int main(int argc, char *argv[]) {
 
 	// NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
 	if (argc < 3) {
-		cerr << "Usage: " << argv[0] << " <input file> <output file> [-v]\n";
+		cerr << "Usage: " << argv[0] << " <input file> <output file> [-v] [--streaming [chunk]]\n";
 		return 1;
 	}
-	const bool verbose_option = argc >= 4 && strcmp(argv[3], "-v") == 0;
+	bool verbose_option = false;
+	bool streaming = false;
+	size_t chunk_size = convex_hull::StreamingHull::DEFAULT_CHUNK;
+	for (int i = 3; i < argc; i++) {
+		if (strcmp(argv[i], "-v") == 0) {
+			verbose_option = true;
+		} else if (strcmp(argv[i], "--streaming") == 0) {
+			streaming = true;
+			if (i + 1 < argc && isdigit(static_cast<unsigned char>(argv[i + 1][0])) != 0) {
+				chunk_size = stoul(argv[++i]);
+			}
+		} else {
+			cerr << "Error: unknown argument " << argv[i] << '\n';
+			return 1;
+		}
+	}
 	if (strcmp(argv[1], "--") == 0) {
 		instream = &cin;
 	} else {
@@ -54,6 +99,41 @@ int main(int argc, char *argv[]) {
 	}
 	// NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
 
+	if (streaming) {
+		// only the fence is computed, the routes would need the whole graph in memory
+		convex_hull::StreamingHull hull(chunk_size);
+		size_t factory_idx = 0;
+		string line;
+		while (getline(*instream, line)) {
+			istringstream iss(line);
+			double x = 0;
+			double y = 0;
+			iss >> x;
+			if (iss >> y) {
+				hull.add_point({x, y});
+			} else {
+				factory_idx = (size_t)x;
+				break;
+			}
+		}
+		hull.finish();
+		if (hull.size() == 0) {
+			cerr << "Error: no points entered\n";
+			return 1;
+		}
+		if (factory_idx < 1) {
+			cerr << "Error: factory index has to be entered and greater than 0\n";
+			return 1;
+		}
+		if (factory_idx > hull.size()) {
+			cerr << "Error: factory index out of bounds\n";
+			return 1;
+		}
+
+		print_fence(*outstream, verbose_option, polygon_perimeter(hull.vertices()), hull.hull());
+		return 0;
+	}
+
 	vector<pair<double, double>> points;
 	size_t factory_idx = 0;
 
@@ -84,12 +164,13 @@ int main(int argc, char *argv[]) {
 		return 1;
 	}
 
-	auto convex_hull = convex_hull::convex_hull(points);
-	double fence_length = 0;
-	for (int i = 0; i < convex_hull.size() - 1; i++) {
-		fence_length += euclidean_distance(points[convex_hull[i]], points[convex_hull[i + 1]]);
+	convex_hull::HullStats hull_stats;
+	auto convex_hull = convex_hull::convex_hull(points, {}, &hull_stats);
+	vector<pair<double, double>> fence;
+	for (const auto &point : convex_hull) {
+		fence.push_back(points[point]);
 	}
-	fence_length += euclidean_distance(points[convex_hull.back()], points[convex_hull.front()]);
+	const double fence_length = polygon_perimeter(fence);
 
 	vector<pair<size_t, size_t>> edges;
 	size_t a = 0;
@@ -100,23 +181,11 @@ int main(int argc, char *argv[]) {
 
 	auto routes = sssp_plane::sssp_plane(points, edges, factory_idx, convex_hull);
 
+	print_fence(*outstream, verbose_option, fence_length, convex_hull);
 	if (verbose_option) {
-		*outstream << "Fence length: " << fence_length << '\n';
-		*outstream << "Fence:";
-		for (const auto &point : convex_hull) {
-			*outstream << ' ' << point + 1;
-		}
-		*outstream << '\n';
+		*outstream << "Points discarded by prefilter: " << hull_stats.discarded_fraction() * 100
+		           << "%\n";
 		*outstream << "Routes:\n";
-	} else {
-		*outstream << fence_length << '\n';
-		if (!convex_hull.empty()) {
-			*outstream << convex_hull.front() + 1;
-		}
-		for (size_t i = 1; i < convex_hull.size(); i++) {
-			*outstream << ' ' << convex_hull[i] + 1;
-		}
-		*outstream << '\n';
 	}
 	for (const auto &route : routes) {
 		if (verbose_option) {
@@ -3,14 +3,14 @@
 #include <algorithm>
 #include <cmath>
 #include <cstddef>
-#include <functional>
 #include <limits>
 #include <optional>
-#include <queue>
 #include <stdexcept>
 #include <utility>
 #include <vector>
 
+#include "vertex_queues.hpp"
+
 /**
  * @brief single source shortest path on a 2d plane
  */
@@ -22,33 +22,33 @@ double distance(const std::pair<double, double> &a, const std::pair<double, doub
 	return std::sqrt(x_dist * x_dist + y_dist * y_dist);
 }
 
-using AdjEdge = std::pair<std::size_t, double>;
-
-void dijkstra(const std::vector<std::vector<AdjEdge>> &adj_list, const std::size_t source,
-              std::vector<double> &dist, std::vector<std::optional<std::size_t>> &parent) {
-	std::priority_queue<AdjEdge, std::vector<AdjEdge>, std::greater<>> q;
-	dist[source] = 0;
-	q.emplace(source, 0);
-	while (!q.empty()) {
-		const std::size_t current_vertex = q.top().first;
-		const double current_dist = q.top().second;
-		q.pop();
-
-		if (dist[current_vertex] < current_dist) continue;
-
-		for (const auto &edge : adj_list[current_vertex]) {
-			const std::size_t v = edge.first;
-			const double d = edge.second;
-			const double potential_dist = current_dist + d;
-			if (dist[v] > potential_dist) {
-				dist[v] = potential_dist;
-				parent[v] = current_vertex;
-				q.emplace(v, dist[v]);
-			}
+/**
+ * @brief Marks the destination vertices
+ * @param vertices: number of vertices
+ * @param destinations: indices of the destination vertices, may repeat
+ * @param is_destination: set to whether each vertex is a destination
+ * @return number of distinct destinations
+ */
+std::size_t mark_destinations(const std::size_t vertices,
+                              const std::vector<std::size_t> &destinations,
+                              std::vector<bool> &is_destination) {
+	is_destination.assign(vertices, false);
+	std::size_t distinct = 0;
+	for (const auto &destination : destinations) {
+		if (!is_destination[destination]) {
+			is_destination[destination] = true;
+			++distinct;
 		}
 	}
+	return distinct;
 }
 
+/**
+ * @brief maximal number of destinations for which Algorithm::automatic chooses A*, the heuristic
+ * costs one distance computation per destination for every reached vertex
+ */
+constexpr std::size_t A_STAR_MAX_DESTINATIONS = 8;
+
 SSSP_Path::SSSP_Path(std::size_t destination, const std::vector<std::size_t> &path, double distance)
     : destination(destination), path(path), length(distance) {}
 
@@ -60,36 +60,207 @@ bool SSSP_Path::operator==(const SSSP_Path &other) const {
 }
 
 /**
- * @brief Computes single source shortest path on a 2d plane
- * @details Uses Dijkstra's algorithm
+ * @brief Validates the edges and computes their lengths
+ * @details Edge lengths stored as float are rounded up, so they are never shorter than the
+ * straight-line distance and the heuristic of A* stays consistent.
  * @param points: points on the plane
  * @param edges: edges described by indeces of points in `points`, each edge must be defined once
  * (each direction is considered a separate edge)
- * @param source: index of the source point in `points`
- * @param destinations: indices of destination points in `points`
- * @return pairs of the index of the destination point and the path to it
  */
-std::vector<SSSP_Path> sssp_plane(const std::vector<Point> &points, const std::vector<Edge> &edges,
-                                  std::size_t source,
-                                  const std::vector<std::size_t> &destinations) {
-	if (source >= points.size()) {
-		throw std::out_of_range("source index out of range");
-	}
+template <typename Weight>
+BasicPlaneGraph<Weight>::BasicPlaneGraph(const std::vector<Point> &points,
+                                         const std::vector<Edge> &edges)
+    : points(points), offsets(points.size() + 1, 0), targets(edges.size()),
+      weights(edges.size()) {
 	for (const auto &edge : edges) {
 		if (edge.first >= points.size() || edge.second >= points.size()) {
 			throw std::out_of_range("edge index out of range");
 		}
+		++offsets[edge.first + 1];
+	}
+	for (std::size_t v = 0; v < points.size(); ++v) {
+		offsets[v + 1] += offsets[v];
 	}
-	std::vector<std::vector<std::pair<std::size_t, double>>> adj_list(points.size());
+
+	// edges of every vertex keep their input order
+	std::vector<std::size_t> next(offsets.begin(), offsets.end() - 1);
 	for (const auto &edge : edges) {
-		const double dist = distance(points[edge.first], points[edge.second]);
-		adj_list[edge.first].emplace_back(edge.second, dist);
+		const double length = distance(points[edge.first], points[edge.second]);
+		Weight weight = static_cast<Weight>(length);
+		if (weight < length) {
+			weight = std::nextafter(weight, std::numeric_limits<Weight>::infinity());
+		}
+		const std::size_t i = next[edge.first]++;
+		targets[i] = edge.second;
+		weights[i] = weight;
+	}
+}
+
+/**
+ * @return number of vertices
+ */
+template <typename Weight> std::size_t BasicPlaneGraph<Weight>::size() const {
+	return points.size();
+}
+
+/**
+ * @brief Dijkstra's algorithm from `source` which stops once all `destinations` are settled
+ * @param q: empty queue
+ * @param source: index of the source vertex
+ * @param destinations: indices of the destination vertices
+ * @param dist: distances from the source, final for the reachable destinations
+ * @param parent: previous vertices on the shortest paths
+ * @return number of settled vertices
+ */
+template <typename Weight>
+template <typename VertexQueue>
+std::size_t
+BasicPlaneGraph<Weight>::dijkstra(VertexQueue &q, const std::size_t source,
+                                  const std::vector<std::size_t> &destinations,
+                                  std::vector<double> &dist,
+                                  std::vector<std::optional<std::size_t>> &parent) const {
+	std::vector<bool> is_destination;
+	std::size_t remaining = mark_destinations(points.size(), destinations, is_destination);
+	std::size_t settled = 0;
+
+	dist[source] = 0;
+	q.push(source, 0);
+	while (!q.empty() && remaining > 0) {
+		const auto [current_dist, current_vertex] = q.pop();
+
+		if (dist[current_vertex] < current_dist) continue;
+		++settled;
+		if (is_destination[current_vertex]) --remaining;
+
+		for (std::size_t i = offsets[current_vertex]; i < offsets[current_vertex + 1]; ++i) {
+			const std::size_t v = targets[i];
+			const double potential_dist = current_dist + weights[i];
+			if (dist[v] > potential_dist) {
+				dist[v] = potential_dist;
+				parent[v] = current_vertex;
+				q.push(v, dist[v]);
+			}
+		}
+	}
+	return settled;
+}
+
+/**
+ * @brief A* search from `source` which stops once all `destinations` are settled
+ * @details The heuristic is the straight-line distance to the nearest destination. Edge lengths
+ * are at least the straight-line distances, so it is consistent and every settled vertex has its
+ * final distance, as in Dijkstra's algorithm. Settled vertices are not relaxed again, so the
+ * distance of every settled vertex is the sum of the edge lengths along its parents.
+ * @param q: empty queue
+ * @param source: index of the source vertex
+ * @param destinations: indices of the destination vertices
+ * @param dist: distances from the source, final for the reachable destinations
+ * @param parent: previous vertices on the shortest paths
+ * @return number of settled vertices
+ */
+template <typename Weight>
+template <typename VertexQueue>
+std::size_t
+BasicPlaneGraph<Weight>::a_star(VertexQueue &q, const std::size_t source,
+                                const std::vector<std::size_t> &destinations,
+                                std::vector<double> &dist,
+                                std::vector<std::optional<std::size_t>> &parent) const {
+	std::vector<bool> is_destination;
+	std::size_t remaining = mark_destinations(points.size(), destinations, is_destination);
+
+	// heuristic of every vertex, computed when the vertex is first reached
+	std::vector<double> estimate(points.size(), -1);
+	const auto heuristic = [&](const std::size_t v) {
+		if (estimate[v] < 0) {
+			double nearest = std::numeric_limits<double>::infinity();
+			for (const auto &destination : destinations) {
+				nearest = std::min(nearest, distance(points[v], points[destination]));
+			}
+			estimate[v] = nearest;
+		}
+		return estimate[v];
+	};
+
+	// the priority is the estimated length of the path through the vertex
+	std::vector<bool> settled(points.size(), false);
+	std::size_t settled_count = 0;
+	dist[source] = 0;
+	q.push(source, heuristic(source));
+	while (!q.empty() && remaining > 0) {
+		const std::size_t current_vertex = q.pop().second;
+
+		if (settled[current_vertex]) continue;
+		settled[current_vertex] = true;
+		++settled_count;
+		if (is_destination[current_vertex]) --remaining;
+
+		for (std::size_t i = offsets[current_vertex]; i < offsets[current_vertex + 1]; ++i) {
+			const std::size_t v = targets[i];
+			const double potential_dist = dist[current_vertex] + weights[i];
+			if (!settled[v] && dist[v] > potential_dist) {
+				dist[v] = potential_dist;
+				parent[v] = current_vertex;
+				q.push(v, potential_dist + heuristic(v));
+			}
+		}
+	}
+	return settled_count;
+}
+
+/**
+ * @brief Computes shortest paths from one source
+ * @details Uses Dijkstra's algorithm or A* search, as selected by `options`. Both stop once all
+ * destinations are settled; A* settles only the vertices closer to the source than the
+ * destinations in the sense of the heuristic. Both find paths of the same length up to rounding.
+ * @param source: index of the source point
+ * @param destinations: indices of destination points
+ * @param options: search algorithm and queue
+ * @param stats: if not null, filled with the number of settled vertices and queue operations
+ * @return pairs of the index of the destination point and the path to it, the length is the sum
+ * of the stored edge lengths
+ */
+template <typename Weight>
+std::vector<SSSP_Path> BasicPlaneGraph<Weight>::query(const std::size_t source,
+                                                      const std::vector<std::size_t> &destinations,
+                                                      const SSSP_Options &options,
+                                                      SSSP_Stats *stats) const {
+	if (source >= points.size()) {
+		throw std::out_of_range("source index out of range");
+	}
+	for (const auto &destination : destinations) {
+		if (destination >= points.size()) {
+			throw std::out_of_range("destination index out of range");
+		}
 	}
 
 	std::vector<double> dist(points.size(), std::numeric_limits<double>::infinity());
 	std::vector<std::optional<std::size_t>> parent(points.size(), std::nullopt);
 
-	dijkstra(adj_list, source, dist, parent);
+	const bool use_a_star = options.algorithm == Algorithm::a_star ||
+	                        (options.algorithm == Algorithm::automatic &&
+	                         destinations.size() <= A_STAR_MAX_DESTINATIONS);
+	const auto search = [&](auto &&q) {
+		const std::size_t settled = use_a_star ? a_star(q, source, destinations, dist, parent)
+		                                       : dijkstra(q, source, destinations, dist, parent);
+		if (stats != nullptr) {
+			stats->settled = settled;
+			stats->pushes = q.pushes;
+			stats->decrease_keys = q.decrease_keys;
+			stats->pops = q.pops;
+			stats->peak_queue_bytes = q.peak_bytes;
+		}
+	};
+	switch (options.queue) {
+	case Queue::binary_heap:
+		search(BinaryHeap(points.size()));
+		break;
+	case Queue::indexed_heap:
+		search(IndexedHeap(points.size()));
+		break;
+	case Queue::radix_heap:
+		search(RadixHeap(points.size()));
+		break;
+	}
 
 	std::vector<SSSP_Path> result;
 	result.reserve(destinations.size());
@@ -113,4 +284,26 @@ std::vector<SSSP_Path> sssp_plane(const std::vector<Point> &points, const std::v
 	return result;
 }
 
+template class BasicPlaneGraph<float>;
+template class BasicPlaneGraph<double>;
+
+/**
+ * @brief Computes single source shortest path on a 2d plane
+ * @details Builds a PlaneGraph for a single query, see BasicPlaneGraph::query()
+ * @param points: points on the plane
+ * @param edges: edges described by indeces of points in `points`, each edge must be defined once
+ * (each direction is considered a separate edge)
+ * @param source: index of the source point in `points`
+ * @param destinations: indices of destination points in `points`
+ * @param options: search algorithm and queue
+ * @param stats: if not null, filled with the number of settled vertices and queue operations
+ * @return pairs of the index of the destination point and the path to it
+ */
+std::vector<SSSP_Path> sssp_plane(const std::vector<Point> &points, const std::vector<Edge> &edges,
+                                  std::size_t source,
+                                  const std::vector<std::size_t> &destinations,
+                                  const SSSP_Options &options, SSSP_Stats *stats) {
+	return PlaneGraph(points, edges).query(source, destinations, options, stats);
+}
+
 }
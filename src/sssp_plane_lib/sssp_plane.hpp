@@ -2,6 +2,7 @@
 #define SSSP_PLANE_H
 
 #include <cstddef>
+#include <optional>
 #include <utility>
 #include <vector>
 
@@ -10,6 +11,77 @@ namespace sssp_plane {
 using Point = std::pair<double, double>;
 using Edge = std::pair<std::size_t, std::size_t>;
 
+/**
+ * @brief search algorithm used by sssp_plane::sssp_plane()
+ */
+enum class Algorithm {
+	/**
+	 * @brief Dijkstra's algorithm
+	 */
+	dijkstra,
+	/**
+	 * @brief A* search guided by the straight-line distance to the nearest destination, stops
+	 * once all destinations are settled
+	 */
+	a_star,
+	/**
+	 * @brief A* if there are only a few destinations, Dijkstra's algorithm otherwise
+	 */
+	automatic
+};
+
+/**
+ * @brief priority queue of vertices used by sssp_plane::sssp_plane()
+ */
+enum class Queue {
+	/**
+	 * @brief binary heap which keeps outdated entries instead of decreasing their priority
+	 */
+	binary_heap,
+	/**
+	 * @brief 4-ary heap with decrease-key and the position of every vertex in an array
+	 */
+	indexed_heap,
+	/**
+	 * @brief monotone radix heap over the bits of the priorities, keeps outdated entries
+	 */
+	radix_heap
+};
+
+/**
+ * @brief options for sssp_plane::sssp_plane()
+ */
+struct SSSP_Options {
+	Algorithm algorithm = Algorithm::automatic;
+	Queue queue = Queue::radix_heap;
+};
+
+/**
+ * @brief instrumentation output of sssp_plane::sssp_plane()
+ */
+struct SSSP_Stats {
+	/**
+	 * @brief number of vertices whose distance from the source was finalized by the search
+	 */
+	std::size_t settled = 0;
+	/**
+	 * @brief number of vertices inserted into the queue, including outdated copies
+	 */
+	std::size_t pushes = 0;
+	/**
+	 * @brief number of priorities lowered in place
+	 */
+	std::size_t decrease_keys = 0;
+	/**
+	 * @brief number of entries removed from the queue, including outdated ones
+	 */
+	std::size_t pops = 0;
+	/**
+	 * @brief peak memory of the queue in bytes, including arrays indexed by vertex
+	 */
+	std::size_t peak_queue_bytes = 0;
+};
+
 /**
  * @brief result type for sssp_plane::sssp_plane()
  */
@@ -32,8 +104,51 @@ struct SSSP_Path {
 	bool operator==(const SSSP_Path &other) const;
 };
 
+/**
+ * @brief Graph on a plane prepared once for many shortest path queries
+ * @details Edges are stored in compressed sparse row layout: the edges leaving vertex `v` are
+ * `targets[offsets[v]]` to `targets[offsets[v + 1] - 1]`, their lengths are stored in `weights` at
+ * the same positions. `Weight` is the type of the stored edge lengths, float halves the memory of
+ * the weights while distances are still summed in double.
+ */
+template <typename Weight> class BasicPlaneGraph {
+  public:
+	BasicPlaneGraph(const std::vector<Point> &points, const std::vector<Edge> &edges);
+
+	std::size_t size() const;
+
+	std::vector<SSSP_Path> query(std::size_t source, const std::vector<std::size_t> &destinations,
+	                             const SSSP_Options &options = {},
+	                             SSSP_Stats *stats = nullptr) const;
+
+  private:
+	std::vector<Point> points;
+	/**
+	 * @brief start of the edges of every vertex in `targets` and `weights`, followed by the number
+	 * of edges
+	 */
+	std::vector<std::size_t> offsets;
+	std::vector<std::size_t> targets;
+	std::vector<Weight> weights;
+
+	template <typename VertexQueue>
+	std::size_t dijkstra(VertexQueue &q, std::size_t source,
+	                     const std::vector<std::size_t> &destinations, std::vector<double> &dist,
+	                     std::vector<std::optional<std::size_t>> &parent) const;
+	template <typename VertexQueue>
+	std::size_t a_star(VertexQueue &q, std::size_t source,
+	                   const std::vector<std::size_t> &destinations, std::vector<double> &dist,
+	                   std::vector<std::optional<std::size_t>> &parent) const;
+};
+
+extern template class BasicPlaneGraph<float>;
+extern template class BasicPlaneGraph<double>;
+
+using PlaneGraph = BasicPlaneGraph<double>;
+
 std::vector<SSSP_Path> sssp_plane(const std::vector<Point> &points, const std::vector<Edge> &edges,
-                                  std::size_t source, const std::vector<std::size_t> &destinations);
+                                  std::size_t source, const std::vector<std::size_t> &destinations,
+                                  const SSSP_Options &options = {}, SSSP_Stats *stats = nullptr);
 
 }
 
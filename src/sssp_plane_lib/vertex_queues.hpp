@@ -0,0 +1,223 @@
+#ifndef VERTEX_QUEUES_H
+#define VERTEX_QUEUES_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+#include <vector>
+
+namespace sssp_plane {
+
+/**
+ * @brief pairs of the priority of a vertex and the vertex, ordered by priority
+ */
+using QueueEntry = std::pair<double, std::size_t>;
+
+/**
+ * @brief operation counts and peak memory of a vertex queue, copied to SSSP_Stats
+ */
+struct QueueCounters {
+	std::size_t pushes = 0;
+	std::size_t decrease_keys = 0;
+	std::size_t pops = 0;
+	std::size_t peak_bytes = 0;
+};
+
+/**
+ * @brief Binary heap without decrease-key
+ * @details push() of a queued vertex adds another entry, pop() may return entries with priority
+ * higher than the current one of their vertex, which the search skips.
+ */
+class BinaryHeap : public QueueCounters {
+  public:
+	explicit BinaryHeap(std::size_t /* vertices */) {}
+
+	bool empty() const {
+		return q.empty();
+	}
+
+	void push(std::size_t vertex, double key) {
+		++pushes;
+		q.emplace(key, vertex);
+		peak_bytes = std::max(peak_bytes, q.size() * sizeof(QueueEntry));
+	}
+
+	QueueEntry pop() {
+		++pops;
+		const QueueEntry top = q.top();
+		q.pop();
+		return top;
+	}
+
+  private:
+	std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<>> q;
+};
+
+/**
+ * @brief 4-ary heap with decrease-key holding every vertex at most once
+ * @details The position of every vertex in the heap is kept in an array indexed by vertex, so
+ * push() of a queued vertex lowers its priority in place. Once popped a vertex must not be pushed
+ * with a lower priority than it was popped with.
+ */
+class IndexedHeap : public QueueCounters {
+  public:
+	static constexpr std::size_t ARITY = 4;
+
+	explicit IndexedHeap(std::size_t vertices) : position(vertices, NONE) {
+		peak_bytes = vertices * sizeof(std::size_t);
+	}
+
+	bool empty() const {
+		return heap.empty();
+	}
+
+	void push(std::size_t vertex, double key) {
+		std::size_t i = position[vertex];
+		if (i == NONE) {
+			++pushes;
+			i = heap.size();
+			heap.emplace_back(key, vertex);
+			peak_bytes = std::max(peak_bytes, position.size() * sizeof(std::size_t) +
+			                                      heap.size() * sizeof(QueueEntry));
+		} else {
+			if (key >= heap[i].first) return;
+			++decrease_keys;
+			heap[i].first = key;
+		}
+		sift_up(i);
+	}
+
+	QueueEntry pop() {
+		++pops;
+		const QueueEntry top = heap.front();
+		position[top.second] = NONE;
+		heap.front() = heap.back();
+		heap.pop_back();
+		if (!heap.empty()) sift_down(0);
+		return top;
+	}
+
+  private:
+	static constexpr std::size_t NONE = std::numeric_limits<std::size_t>::max();
+
+	std::vector<QueueEntry> heap;
+	std::vector<std::size_t> position;
+
+	void sift_up(std::size_t i) {
+		const QueueEntry entry = heap[i];
+		while (i > 0) {
+			const std::size_t parent = (i - 1) / ARITY;
+			if (!(entry < heap[parent])) break;
+			heap[i] = heap[parent];
+			position[heap[i].second] = i;
+			i = parent;
+		}
+		heap[i] = entry;
+		position[entry.second] = i;
+	}
+
+	void sift_down(std::size_t i) {
+		const QueueEntry entry = heap[i];
+		while (true) {
+			const std::size_t first = i * ARITY + 1;
+			if (first >= heap.size()) break;
+			const std::size_t last = std::min(first + ARITY, heap.size());
+			std::size_t child = first;
+			for (std::size_t c = first + 1; c < last; ++c) {
+				if (heap[c] < heap[child]) child = c;
+			}
+			if (!(heap[child] < entry)) break;
+			heap[i] = heap[child];
+			position[heap[i].second] = i;
+			i = child;
+		}
+		heap[i] = entry;
+		position[entry.second] = i;
+	}
+};
+
+/**
+ * @brief Monotone radix heap for non-negative priorities, without decrease-key like BinaryHeap
+ * @details Non-negative doubles are ordered like their bit patterns. An entry is kept in the
+ * bucket of the highest bit in which its priority differs from the last popped one, so each entry
+ * moves to a lower bucket at most 64 times. Priorities lower than the last popped one, which only
+ * come from rounding in A*, are raised to it.
+ */
+class RadixHeap : public QueueCounters {
+  public:
+	explicit RadixHeap(std::size_t /* vertices */) {}
+
+	bool empty() const {
+		return size == 0;
+	}
+
+	void push(std::size_t vertex, double key) {
+		++pushes;
+		const std::uint64_t bits = std::max(to_bits(key), last);
+		insert({bits, vertex});
+		++size;
+		peak_bytes = std::max(peak_bytes, size * sizeof(Entry));
+	}
+
+	QueueEntry pop() {
+		++pops;
+		if (buckets[0].empty()) {
+			const std::size_t i = 1 + static_cast<std::size_t>(__builtin_ctzll(nonempty));
+			last = std::min_element(buckets[i].begin(), buckets[i].end())->first;
+			nonempty &= ~(std::uint64_t{1} << (i - 1));
+			for (const Entry &entry : buckets[i]) {
+				insert(entry);
+			}
+			buckets[i].clear();
+		}
+		const Entry top = buckets[0].back();
+		buckets[0].pop_back();
+		--size;
+
+		double key = 0;
+		std::memcpy(&key, &top.first, sizeof(key));
+		return {key, top.second};
+	}
+
+  private:
+	using Entry = std::pair<std::uint64_t, std::size_t>;
+
+	std::array<std::vector<Entry>, 65> buckets;
+	/**
+	 * @brief bit `i - 1` is set if bucket `i` is not empty, for `i` from 1
+	 */
+	std::uint64_t nonempty = 0;
+	std::uint64_t last = 0;
+	std::size_t size = 0;
+
+	void insert(const Entry &entry) {
+		const std::size_t i = bucket(entry.first);
+		buckets[i].push_back(entry);
+		if (i > 0) nonempty |= std::uint64_t{1} << (i - 1);
+	}
+
+	static std::uint64_t to_bits(double key) {
+		std::uint64_t bits = 0;
+		std::memcpy(&bits, &key, sizeof(bits));
+		return bits;
+	}
+
+	/**
+	 * @return 0 for the last popped priority, otherwise one more than the index of the highest bit
+	 * in which `bits` differs from it
+	 */
+	std::size_t bucket(std::uint64_t bits) const {
+		const std::uint64_t diff = bits ^ last;
+		return diff == 0 ? 0 : 64 - static_cast<std::size_t>(__builtin_clzll(diff));
+	}
+};
+
+}
+
+#endif
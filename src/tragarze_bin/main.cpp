@@ -1,11 +1,14 @@
+#include <cctype>
 #include <cstddef>
 #include <cstring>
 #include <fstream>
 #include <iostream>
+#include <string>
 #include <utility>
 #include <vector>
 
 #include "../bipartite_maximum_matching_lib/bipartite_maximum_matching.hpp"
+#include "../bipartite_maximum_matching_lib/streaming_matcher.hpp"
 
 using namespace std;
 
@@ -18,7 +21,8 @@ int main(int argc, char *argv[]) {
 
 	// NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
 	if (argc < 2) {
-		cerr << "Usage: " << argv[0] << " <input file> <output file>\n";
+		cerr << "Usage: " << argv[0]
+		     << " <input file> <output file> [--initial <matching file>] [--streaming [passes]]\n";
 		return 1;
 	}
 	if (strcmp(argv[1], "--") == 0) {
@@ -41,15 +45,68 @@ int main(int argc, char *argv[]) {
 		}
 		outstream = &outfile;
 	}
+
+	bipartite_maximum_matching::MatchingOptions options;
+	bool streaming = false;
+	size_t extra_passes = 0;
+	for (int i = 3; i < argc; i++) {
+		if (strcmp(argv[i], "--initial") == 0 && i + 1 < argc) {
+			ifstream initial_file(argv[++i]);
+			if (!initial_file) {
+				cerr << "Error: could not open initial matching file\n";
+				return 1;
+			}
+			size_t a = 0;
+			size_t b = 0;
+			while (initial_file >> a >> b) {
+				options.initial_matching.emplace_back(a - 1, b - 1);
+			}
+		} else if (strcmp(argv[i], "--streaming") == 0) {
+			streaming = true;
+			if (i + 1 < argc && isdigit(static_cast<unsigned char>(argv[i + 1][0])) != 0) {
+				extra_passes = stoul(argv[++i]);
+			}
+		} else {
+			cerr << "Error: unknown argument " << argv[i] << '\n';
+			return 1;
+		}
+	}
 	// NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
 
+	if (streaming) {
+		if (!options.initial_matching.empty()) {
+			cerr << "Error: --initial cannot be used with --streaming\n";
+			return 1;
+		}
+		if (extra_passes > 0 && instream == &cin) {
+			cerr << "Error: extra streaming passes need an input file\n";
+			return 1;
+		}
+
+		bipartite_maximum_matching::StreamingMatcher matcher;
+		while (true) {
+			size_t a = 0;
+			size_t b = 0;
+			while (*instream >> a >> b) {
+				matcher.add_edge(a - 1, b - 1);
+			}
+			if (!matcher.finish_pass() || matcher.passes() > extra_passes) break;
+			infile.clear();
+			infile.seekg(0);
+		}
+		for (auto &p : matcher.matching()) {
+			*outstream << p.first + 1 << " " << p.second + 1 << '\n';
+		}
+		return 0;
+	}
+
 	vector<pair<size_t, size_t>> input;
 	size_t a = 0;
 	size_t b = 0;
 	while (*instream >> a >> b) {
 		input.emplace_back(a - 1, b - 1);
 	}
-	auto result = bipartite_maximum_matching::bipartite_maximum_matching(input);
+	auto result = bipartite_maximum_matching::bipartite_maximum_matching(input, options);
 	for (auto &p : result) {
 		*outstream << p.first + 1 << " " << p.second + 1 << '\n';
 	}
@@ -1,8 +1,12 @@
+#include <algorithm>
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <cstddef>
 #include <ctime>
+#include <functional>
 #include <random>
 #include <set>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -15,6 +19,14 @@ bool is_maximal_matching(const std::vector<std::pair<size_t, size_t>> &matching,
 std::vector<std::pair<size_t, size_t>>
 generate_random_bipartite_graph(size_t left_num, size_t right_num, size_t edge_num);
 
+// simple O(VE) reference used to check the size of the matching
+size_t maximum_matching_size(const std::vector<std::pair<size_t, size_t>> &edges);
+
+bool is_valid_b_matching(const std::vector<std::pair<size_t, size_t>> &matching,
+                         const std::vector<std::pair<size_t, size_t>> &edges,
+                         const std::vector<size_t> &left_capacity,
+                         const std::vector<size_t> &right_capacity);
+
 TEST_CASE("bipartite_maximum_matching empty", "[bipartite_maximum_matching]") {
 	std::vector<std::pair<size_t, size_t>> in = {};
 	auto result = bipartite_maximum_matching::bipartite_maximum_matching(in);
@@ -61,6 +73,238 @@ TEST_CASE("bipartite_maximum_matching randomized large", "[bipartite_maximum_mat
 	REQUIRE(is_maximal_matching(result, in));
 }
 
+TEST_CASE("bipartite_maximum_matching is maximum", "[bipartite_maximum_matching]") {
+	for (size_t i = 0; i < 20; i++) {
+		std::vector<std::pair<size_t, size_t>> in = generate_random_bipartite_graph(60, 50, 120);
+		auto result = bipartite_maximum_matching::bipartite_maximum_matching(in);
+		REQUIRE(is_maximal_matching(result, in));
+		REQUIRE(result.size() == maximum_matching_size(in));
+	}
+}
+
+TEST_CASE("bipartite_maximum_matching long augmenting path", "[bipartite_maximum_matching]") {
+	// greedy matches i with i, the only perfect matching is i with i + 1 and n with 0
+	const size_t n = 100000;
+	std::vector<std::pair<size_t, size_t>> in;
+	for (size_t i = 0; i < n; i++) {
+		in.emplace_back(i, i);
+		in.emplace_back(i, i + 1);
+	}
+	in.emplace_back(n, 0);
+	auto result = bipartite_maximum_matching::bipartite_maximum_matching(in);
+	REQUIRE(is_maximal_matching(result, in));
+	REQUIRE(result.size() == n + 1);
+}
+
+TEST_CASE("bipartite_maximum_matching large sparse", "[bipartite_maximum_matching]") {
+	std::vector<std::pair<size_t, size_t>> in =
+	    generate_random_bipartite_graph(200000, 200000, 600000);
+	auto result = bipartite_maximum_matching::bipartite_maximum_matching(in);
+	REQUIRE(is_maximal_matching(result, in));
+}
+
+TEST_CASE("bipartite_maximum_matching without warm start", "[bipartite_maximum_matching]") {
+	bipartite_maximum_matching::MatchingOptions options;
+	options.warm_start = false;
+	for (size_t i = 0; i < 10; i++) {
+		std::vector<std::pair<size_t, size_t>> in = generate_random_bipartite_graph(60, 50, 120);
+		auto result = bipartite_maximum_matching::bipartite_maximum_matching(in, options);
+		REQUIRE(is_maximal_matching(result, in));
+		REQUIRE(result.size() == maximum_matching_size(in));
+	}
+}
+
+TEST_CASE("bipartite_maximum_matching initial matching", "[bipartite_maximum_matching]") {
+	std::vector<std::pair<size_t, size_t>> in = {{0, 0}, {0, 1}, {1, 0}, {2, 1}, {2, 2}};
+	bipartite_maximum_matching::MatchingOptions options;
+	options.warm_start = false;
+
+	SECTION("is kept when it is already maximum") {
+		options.initial_matching = {{0, 1}, {1, 0}, {2, 2}};
+		auto result = bipartite_maximum_matching::bipartite_maximum_matching(in, options);
+		REQUIRE(result == options.initial_matching);
+	}
+
+	SECTION("is extended to a maximum matching") {
+		options.initial_matching = {{0, 0}, {2, 1}};
+		auto result = bipartite_maximum_matching::bipartite_maximum_matching(in, options);
+		REQUIRE(is_maximal_matching(result, in));
+		REQUIRE(result.size() == 3);
+	}
+
+	SECTION("ignores invalid and conflicting pairs") {
+		options.initial_matching = {{0, 2}, {5, 5}, {1, 0}, {0, 0}, {2, 2}};
+		auto result = bipartite_maximum_matching::bipartite_maximum_matching(in, options);
+		REQUIRE(is_maximal_matching(result, in));
+		REQUIRE(result.size() == 3);
+	}
+}
+
+TEST_CASE("bipartite_maximum_matching randomized initial matching",
+          "[bipartite_maximum_matching]") {
+	for (size_t i = 0; i < 10; i++) {
+		std::vector<std::pair<size_t, size_t>> in = generate_random_bipartite_graph(60, 50, 120);
+		bipartite_maximum_matching::MatchingOptions options;
+		options.initial_matching = generate_random_bipartite_graph(60, 50, 30);
+		auto result = bipartite_maximum_matching::bipartite_maximum_matching(in, options);
+		REQUIRE(is_maximal_matching(result, in));
+		REQUIRE(result.size() == maximum_matching_size(in));
+	}
+}
+
+TEST_CASE("bipartite_maximum_matching parallel", "[bipartite_maximum_matching]") {
+	bipartite_maximum_matching::MatchingOptions options;
+	options.threads = 4;
+
+	SECTION("matches the sequential size on random graphs") {
+		for (size_t i = 0; i < 10; i++) {
+			std::vector<std::pair<size_t, size_t>> in =
+			    generate_random_bipartite_graph(60, 50, 120);
+			auto result = bipartite_maximum_matching::bipartite_maximum_matching(in, options);
+			REQUIRE(is_maximal_matching(result, in));
+			REQUIRE(result.size() == maximum_matching_size(in));
+		}
+	}
+
+	SECTION("matches the sequential size on a large graph") {
+		std::vector<std::pair<size_t, size_t>> in =
+		    generate_random_bipartite_graph(100000, 100000, 300000);
+		options.warm_start = false;
+		auto parallel = bipartite_maximum_matching::bipartite_maximum_matching(in, options);
+		auto sequential = bipartite_maximum_matching::bipartite_maximum_matching(in);
+		REQUIRE(is_maximal_matching(parallel, in));
+		REQUIRE(parallel.size() == sequential.size());
+	}
+}
+
+TEST_CASE("bipartite_maximum_matching split components", "[bipartite_maximum_matching]") {
+	bipartite_maximum_matching::MatchingOptions options;
+	options.split_components = true;
+
+	SECTION("lista3zad1") {
+		std::vector<std::pair<size_t, size_t>> in = {{0, 0}, {0, 1}, {1, 2}, {2, 1}, {2, 2}, {2, 4},
+		                                             {2, 5}, {3, 3}, {3, 5}, {4, 2}, {4, 4}};
+		auto result = bipartite_maximum_matching::bipartite_maximum_matching(in, options);
+		REQUIRE(is_maximal_matching(result, in));
+		REQUIRE(result.size() == 5);
+	}
+
+	SECTION("many small and one large component") {
+		// 1000 copies of a small random graph, each with separate vertices, and one large graph
+		std::vector<std::pair<size_t, size_t>> in;
+		size_t expected = 0;
+		for (size_t i = 0; i < 1000; i++) {
+			auto small = generate_random_bipartite_graph(6, 6, 8);
+			expected += maximum_matching_size(small);
+			for (auto &edge : small) {
+				in.emplace_back(edge.first * 1000 + i, edge.second * 1000 + i);
+			}
+		}
+		auto large = generate_random_bipartite_graph(300, 300, 600);
+		expected += maximum_matching_size(large);
+		for (auto &edge : large) {
+			in.emplace_back(edge.first + 6000, edge.second + 6000);
+		}
+
+		for (const size_t threads : {1, 4}) {
+			options.threads = threads;
+			for (const bool warm_start : {false, true}) {
+				options.warm_start = warm_start;
+				auto result = bipartite_maximum_matching::bipartite_maximum_matching(in, options);
+				REQUIRE(is_maximal_matching(result, in));
+				REQUIRE(result.size() == expected);
+				REQUIRE(std::is_sorted(result.begin(), result.end()));
+			}
+		}
+	}
+}
+
+TEST_CASE("bipartite_b_matching", "[bipartite_maximum_matching]") {
+	SECTION("empty") {
+		REQUIRE(bipartite_maximum_matching::bipartite_b_matching({}, {}, {}).empty());
+	}
+
+	SECTION("unit capacities give a maximum matching") {
+		std::vector<std::pair<size_t, size_t>> in = generate_random_bipartite_graph(60, 50, 120);
+		auto result = bipartite_maximum_matching::bipartite_b_matching(in, {}, {});
+		REQUIRE(is_maximal_matching(result, in));
+		REQUIRE(result.size() == maximum_matching_size(in));
+	}
+
+	SECTION("star") {
+		std::vector<std::pair<size_t, size_t>> in = {{0, 0}, {0, 1}, {0, 2}, {0, 3}, {1, 3}};
+		auto result = bipartite_maximum_matching::bipartite_b_matching(in, {3, 1}, {});
+		REQUIRE(is_valid_b_matching(result, in, {3, 1}, {}));
+		REQUIRE(result.size() == 4);
+
+		result = bipartite_maximum_matching::bipartite_b_matching(in, {3, 1}, {1, 1, 1, 0});
+		REQUIRE(is_valid_b_matching(result, in, {3, 1}, {1, 1, 1, 0}));
+		REQUIRE(result.size() == 3);
+	}
+
+	SECTION("repeated pairs are used once") {
+		auto result = bipartite_maximum_matching::bipartite_b_matching({{0, 0}, {0, 0}}, {2}, {2});
+		REQUIRE(result == std::vector<std::pair<size_t, size_t>>{{0, 0}});
+
+		std::vector<std::pair<size_t, size_t>> in = {{0, 1}, {1, 0}, {0, 1}, {0, 0}, {0, 1}};
+		result = bipartite_maximum_matching::bipartite_b_matching(in, {3, 1}, {2, 2});
+		REQUIRE(is_valid_b_matching(result, in, {3, 1}, {2, 2}));
+		REQUIRE(result.size() == 3);
+	}
+
+	SECTION("matches vertex duplication") {
+		std::default_random_engine gen(time(NULL));
+		std::uniform_int_distribution<size_t> capacity_dist(0, 3);
+		for (size_t i = 0; i < 10; i++) {
+			std::vector<std::pair<size_t, size_t>> in = generate_random_bipartite_graph(30, 30, 90);
+			std::vector<size_t> left_capacity(30);
+			std::vector<size_t> right_capacity(30);
+			for (size_t j = 0; j < 30; j++) {
+				left_capacity[j] = capacity_dist(gen);
+				right_capacity[j] = capacity_dist(gen);
+			}
+
+			// copy k of vertex u is u * 4 + k, duplicated edges between copies would allow
+			// using one pair several times, so every pair gets its own middle vertex pair
+			std::vector<std::pair<size_t, size_t>> duplicated;
+			for (size_t e = 0; e < in.size(); e++) {
+				for (size_t k = 0; k < left_capacity[in[e].first]; k++) {
+					duplicated.emplace_back(in[e].first * 4 + k, 200 + e);
+				}
+				duplicated.emplace_back(1000 + e, 200 + e);
+				for (size_t k = 0; k < right_capacity[in[e].second]; k++) {
+					duplicated.emplace_back(1000 + e, in[e].second * 4 + k);
+				}
+			}
+
+			auto result =
+			    bipartite_maximum_matching::bipartite_b_matching(in, left_capacity, right_capacity);
+			REQUIRE(is_valid_b_matching(result, in, left_capacity, right_capacity));
+			REQUIRE(result.size() + in.size() == maximum_matching_size(duplicated));
+
+			result = bipartite_maximum_matching::bipartite_b_matching(
+			    in, left_capacity, right_capacity,
+			    bipartite_maximum_matching::FlowNetwork::Algorithm::push_relabel);
+			REQUIRE(is_valid_b_matching(result, in, left_capacity, right_capacity));
+			REQUIRE(result.size() + in.size() == maximum_matching_size(duplicated));
+		}
+	}
+}
+
+TEST_CASE("bipartite_maximum_matching benchmark", "[.][benchmark][bipartite_maximum_matching]") {
+	std::vector<std::pair<size_t, size_t>> in =
+	    generate_random_bipartite_graph(200000, 200000, 800000);
+	bipartite_maximum_matching::MatchingOptions options;
+	options.warm_start = false;
+
+	for (const size_t threads : {1, 2, 4, 8}) {
+		options.threads = threads;
+		BENCHMARK("hopcroft-karp " + std::to_string(threads) + " threads") {
+			return bipartite_maximum_matching::bipartite_maximum_matching(in, options);
+		};
+	}
+}
+
 std::vector<std::pair<size_t, size_t>>
 generate_random_bipartite_graph(size_t left_num, size_t right_num, size_t edge_num) {
 	std::set<std::pair<size_t, size_t>> edges;
@@ -107,3 +351,59 @@ bool is_maximal_matching(const std::vector<std::pair<size_t, size_t>> &matching,
 
 	return true;
 }
+
+size_t maximum_matching_size(const std::vector<std::pair<size_t, size_t>> &edges) {
+	size_t left_num = 0;
+	size_t right_num = 0;
+	for (auto &edge : edges) {
+		left_num = std::max(left_num, edge.first + 1);
+		right_num = std::max(right_num, edge.second + 1);
+	}
+	std::vector<std::vector<size_t>> adj(left_num);
+	for (auto &edge : edges) {
+		adj[edge.first].push_back(edge.second);
+	}
+
+	std::vector<size_t> match(right_num, left_num);
+	std::vector<bool> visited;
+	std::function<bool(size_t)> kuhn = [&](size_t u) {
+		for (size_t v : adj[u]) {
+			if (visited[v]) continue;
+			visited[v] = true;
+			if (match[v] == left_num || kuhn(match[v])) {
+				match[v] = u;
+				return true;
+			}
+		}
+		return false;
+	};
+
+	size_t result = 0;
+	for (size_t u = 0; u < left_num; u++) {
+		visited.assign(right_num, false);
+		if (kuhn(u)) result++;
+	}
+	return result;
+}
+
+bool is_valid_b_matching(const std::vector<std::pair<size_t, size_t>> &matching,
+                         const std::vector<std::pair<size_t, size_t>> &edges,
+                         const std::vector<size_t> &left_capacity,
+                         const std::vector<size_t> &right_capacity) {
+	const std::set<std::pair<size_t, size_t>> edges_set(edges.begin(), edges.end());
+	std::set<std::pair<size_t, size_t>> used;
+	std::vector<size_t> left_used;
+	std::vector<size_t> right_used;
+	for (auto &pair : matching) {
+		if (edges_set.count(pair) == 0 || !used.insert(pair).second) return false;
+		left_used.resize(std::max(left_used.size(), pair.first + 1), 0);
+		right_used.resize(std::max(right_used.size(), pair.second + 1), 0);
+		const size_t left_limit = pair.first < left_capacity.size() ? left_capacity[pair.first] : 1;
+		const size_t right_limit =
+		    pair.second < right_capacity.size() ? right_capacity[pair.second] : 1;
+		if (++left_used[pair.first] > left_limit || ++right_used[pair.second] > right_limit) {
+			return false;
+		}
+	}
+	return true;
+}
@@ -1,8 +1,12 @@
 #include <algorithm>
 #include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <cstdint>
 #include <ctime>
+#include <limits>
 #include <random>
 #include <set>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -166,6 +170,489 @@ SCENARIO("Convex Hull is calculated correctly") {
 	}
 }
 
+SCENARIO("Monotone chain gives the same hull as Graham's scan") {
+	convex_hull::HullOptions options;
+	options.algorithm = convex_hull::Algorithm::monotone_chain;
+
+	GIVEN("Degenerate sets") {
+		const vector<vector<Point>> sets = {
+		    {},
+		    {{7.3, 8.23}},
+		    {{3.14, 2.71}, {1.61, 9.81}},
+		    {{1, 1}, {2, 2}, {3, 3}},
+		    {{1, 1}, {1, 2}, {1, 3}},
+		    {{3, 1}, {2, 1}, {1, 1}},
+		    {{1, 1}, {2, 3}, {3, 2}, {2, 2}},
+		    {{-0.0, 1}, {0, -1}, {-1, 0}, {1, 0}, {0, 0}},
+		};
+
+		THEN("The hulls are identical") {
+			for (const vector<Point> &in : sets) {
+				REQUIRE(convex_hull::convex_hull(in, options) == convex_hull::convex_hull(in));
+			}
+		}
+	}
+
+	GIVEN("Duplicated points") {
+		vector<Point> in = {{2, 2}, {0, 0}, {2, 2}, {0, 2}, {0, 0}, {2, 0}, {1, 1}};
+		vector<size_t> hull = convex_hull::convex_hull(in, options);
+		vector<Point> hull_points;
+		for (size_t i : hull) {
+			hull_points.push_back(in[i]);
+		}
+
+		THEN("Every point appears once") {
+			REQUIRE(hull_points == vector<Point>{{0, 0}, {2, 0}, {2, 2}, {0, 2}});
+		}
+
+		THEN("Every algorithm keeps the first of the duplicates") {
+			for (const auto algorithm :
+			     {convex_hull::Algorithm::graham, convex_hull::Algorithm::monotone_chain,
+			      convex_hull::Algorithm::chan, convex_hull::Algorithm::automatic}) {
+				convex_hull::HullOptions other;
+				other.algorithm = algorithm;
+				REQUIRE(convex_hull::convex_hull(in, other) == vector<size_t>{1, 5, 0, 3});
+			}
+		}
+	}
+
+	GIVEN("Randomized sets") {
+		default_random_engine gen(time(NULL));
+
+		THEN("The hulls are identical") {
+			for (int i = 0; i < 10; ++i) {
+				uniform_real_distribution<double> dist(-1000, 1000);
+				set<Point> in;
+				while (in.size() < 1000) {
+					in.insert({dist(gen), dist(gen)});
+				}
+				vector<Point> in_vec(in.begin(), in.end());
+				shuffle(in_vec.begin(), in_vec.end(), gen);
+				REQUIRE(convex_hull::convex_hull(in_vec, options) ==
+				        convex_hull::convex_hull(in_vec));
+			}
+		}
+
+		THEN("The hulls are identical for grid points with many collinear ones") {
+			for (int i = 0; i < 10; ++i) {
+				uniform_int_distribution<int> dist(-10, 10);
+				set<Point> in;
+				while (in.size() < 200) {
+					in.insert({dist(gen), dist(gen)});
+				}
+				vector<Point> in_vec(in.begin(), in.end());
+				shuffle(in_vec.begin(), in_vec.end(), gen);
+				REQUIRE(convex_hull::convex_hull(in_vec, options) ==
+				        convex_hull::convex_hull(in_vec));
+			}
+		}
+	}
+}
+
+SCENARIO("Prefilter does not change the hull") {
+	convex_hull::HullOptions without_prefilter;
+	without_prefilter.prefilter = false;
+
+	GIVEN("Points in a disc") {
+		default_random_engine gen(time(NULL));
+		uniform_real_distribution<double> angle(0, 6.283185307179586);
+		uniform_real_distribution<double> radius(0, 1);
+
+		vector<Point> in;
+		for (int i = 0; i < 10000; ++i) {
+			const double r = 1000 * sqrt(radius(gen));
+			const double a = angle(gen);
+			in.emplace_back(r * cos(a), r * sin(a));
+		}
+
+		WHEN("Convex Hull is calculated") {
+			convex_hull::HullStats stats;
+			for (const auto algorithm :
+			     {convex_hull::Algorithm::graham, convex_hull::Algorithm::monotone_chain}) {
+				convex_hull::HullOptions options;
+				options.algorithm = algorithm;
+				without_prefilter.algorithm = algorithm;
+				vector<size_t> hull = convex_hull::convex_hull(in, options, &stats);
+
+				THEN("It matches the hull of all points") {
+					REQUIRE(hull == convex_hull::convex_hull(in, without_prefilter));
+				}
+			}
+
+			THEN("Most points are discarded") {
+				REQUIRE(stats.points == in.size());
+				REQUIRE(stats.discarded_fraction() > 0.5);
+				REQUIRE(stats.discarded_fraction() < 1);
+			}
+		}
+	}
+
+	GIVEN("Points on a circle and on the octagon edges") {
+		vector<Point> in = {{0, -2}, {2, 0}, {0, 2}, {-2, 0}, {1, -1}, {1, 1}, {0, 0}, {-1, 1}};
+
+		WHEN("Convex Hull is calculated") {
+			convex_hull::HullStats stats;
+			vector<size_t> hull = convex_hull::convex_hull(in, {}, &stats);
+
+			THEN("Only the strictly inner point is discarded") {
+				REQUIRE(hull == vector<size_t>{0, 1, 2, 3});
+				REQUIRE(stats.discarded == 1);
+			}
+		}
+	}
+}
+
+SCENARIO("Parallel Convex Hull is the same for any number of threads") {
+	GIVEN("Many points close to a circle") {
+		default_random_engine gen(time(NULL));
+		uniform_real_distribution<double> angle(0, 6.283185307179586);
+		uniform_real_distribution<double> radius(999, 1000);
+
+		vector<Point> in;
+		for (int i = 0; i < 300000; ++i) {
+			const double r = radius(gen);
+			const double a = angle(gen);
+			in.emplace_back(r * cos(a), r * sin(a));
+		}
+
+		THEN("The hull matches the sequential one") {
+			for (const auto algorithm :
+			     {convex_hull::Algorithm::graham, convex_hull::Algorithm::monotone_chain}) {
+				for (const bool prefilter : {false, true}) {
+					convex_hull::HullOptions options;
+					options.algorithm = algorithm;
+					options.prefilter = prefilter;
+					const vector<size_t> sequential = convex_hull::convex_hull(in, options);
+
+					for (const size_t threads : {2, 3, 8}) {
+						options.threads = threads;
+						REQUIRE(convex_hull::convex_hull(in, options) == sequential);
+					}
+				}
+			}
+		}
+	}
+
+	GIVEN("Many points with duplicated hull corners in different chunks") {
+		default_random_engine gen(time(NULL));
+		uniform_real_distribution<double> dist(-999, 999);
+		const vector<Point> corners = {{-1000, -1000}, {1000, -1000}, {1000, 1000}, {-1000, 1000}};
+
+		vector<Point> in(300000);
+		for (size_t i = 0; i < in.size(); ++i) {
+			in[i] = i % 1000 == 0 ? corners[(i / 1000) % 4] : Point{dist(gen), dist(gen)};
+		}
+
+		THEN("The hull matches the sequential one") {
+			for (const auto algorithm :
+			     {convex_hull::Algorithm::graham, convex_hull::Algorithm::monotone_chain,
+			      convex_hull::Algorithm::chan, convex_hull::Algorithm::automatic}) {
+				for (const bool prefilter : {false, true}) {
+					convex_hull::HullOptions options;
+					options.algorithm = algorithm;
+					options.prefilter = prefilter;
+					const vector<size_t> sequential = convex_hull::convex_hull(in, options);
+					REQUIRE(sequential == vector<size_t>{0, 1000, 2000, 3000});
+
+					for (const size_t threads : {2, 3, 8}) {
+						options.threads = threads;
+						REQUIRE(convex_hull::convex_hull(in, options) == sequential);
+					}
+				}
+			}
+		}
+	}
+}
+
+SCENARIO("Chan's algorithm gives the same hull as monotone chain") {
+	convex_hull::HullOptions monotone_chain;
+	monotone_chain.algorithm = convex_hull::Algorithm::monotone_chain;
+	monotone_chain.prefilter = false;
+	convex_hull::HullOptions chan = monotone_chain;
+	chan.algorithm = convex_hull::Algorithm::chan;
+	convex_hull::HullOptions automatic = monotone_chain;
+	automatic.algorithm = convex_hull::Algorithm::automatic;
+
+	GIVEN("Degenerate sets") {
+		const vector<vector<Point>> sets = {
+		    {},
+		    {{7.3, 8.23}},
+		    {{3.14, 2.71}, {1.61, 9.81}},
+		    {{1, 1}, {2, 2}, {3, 3}},
+		    {{1, 1}, {1, 2}, {1, 3}},
+		    {{3, 1}, {2, 1}, {1, 1}},
+		    {{1, 1}, {2, 3}, {3, 2}, {2, 2}},
+		    {{2, 2}, {2, 2}, {2, 2}},
+		};
+
+		THEN("The hulls are identical") {
+			for (const vector<Point> &in : sets) {
+				REQUIRE(convex_hull::convex_hull(in, chan) ==
+				        convex_hull::convex_hull(in, monotone_chain));
+			}
+		}
+	}
+
+	GIVEN("Randomized sets") {
+		default_random_engine gen(time(NULL));
+
+		THEN("The hulls are identical for points in a square") {
+			for (int i = 0; i < 10; ++i) {
+				uniform_real_distribution<double> dist(-1000, 1000);
+				vector<Point> in(20000);
+				for (Point &p : in) {
+					p = {dist(gen), dist(gen)};
+				}
+				const vector<size_t> expected = convex_hull::convex_hull(in, monotone_chain);
+				REQUIRE(convex_hull::convex_hull(in, chan) == expected);
+				REQUIRE(convex_hull::convex_hull(in, automatic) == expected);
+			}
+		}
+
+		THEN("The hulls are identical for points close to a circle") {
+			uniform_real_distribution<double> angle(0, 6.283185307179586);
+			uniform_real_distribution<double> radius(999.99, 1000);
+			vector<Point> in(20000);
+			for (Point &p : in) {
+				const double r = radius(gen);
+				const double a = angle(gen);
+				p = {r * cos(a), r * sin(a)};
+			}
+			const vector<size_t> expected = convex_hull::convex_hull(in, monotone_chain);
+			REQUIRE(convex_hull::convex_hull(in, chan) == expected);
+			REQUIRE(convex_hull::convex_hull(in, automatic) == expected);
+		}
+
+		THEN("The hull sets are identical for grid points with duplicates and collinear ones") {
+			for (int i = 0; i < 20; ++i) {
+				uniform_int_distribution<int> dist(-10, 10);
+				vector<Point> in(500);
+				for (Point &p : in) {
+					p = {dist(gen), dist(gen)};
+				}
+
+				convex_hull::HullOptions graham = monotone_chain;
+				graham.algorithm = convex_hull::Algorithm::graham;
+				REQUIRE(convex_hull::convex_hull(in, graham) ==
+				        convex_hull::convex_hull(in, monotone_chain));
+
+				vector<Point> expected;
+				for (size_t j : convex_hull::convex_hull(in, monotone_chain)) {
+					expected.push_back(in[j]);
+				}
+				vector<Point> result;
+				for (size_t j : convex_hull::convex_hull(in, chan)) {
+					result.push_back(in[j]);
+				}
+				REQUIRE(result == expected);
+			}
+		}
+	}
+
+	// every wrap step starts at a vertex of a group hull and grid points form collinear edges,
+	// tangent() asserts that its binary search ends at a tangent in all of these cases
+	GIVEN("Points on which the tangents touch vertices and collinear edges of the groups") {
+		default_random_engine gen(time(NULL));
+
+		THEN("The tangents are found by the binary search on points close to a circle") {
+			uniform_real_distribution<double> angle(0, 6.283185307179586);
+			uniform_real_distribution<double> radius(999.99, 1000);
+			for (const size_t n : {300, 2000, 20000}) {
+				vector<Point> in(n);
+				for (Point &p : in) {
+					const double r = radius(gen);
+					const double a = angle(gen);
+					p = {r * cos(a), r * sin(a)};
+				}
+				REQUIRE(convex_hull::convex_hull(in, chan) ==
+				        convex_hull::convex_hull(in, monotone_chain));
+			}
+		}
+
+		THEN("The tangents are found by the binary search on integer grid points") {
+			for (const int16_t size : {3, 10, 100}) {
+				uniform_int_distribution<int16_t> dist(-size, size);
+				for (const size_t n : {300, 2000, 20000}) {
+					vector<pair<int16_t, int16_t>> in(n);
+					for (auto &p : in) {
+						p = {dist(gen), dist(gen)};
+					}
+					REQUIRE(convex_hull::convex_hull(in, chan) ==
+					        convex_hull::convex_hull(in, monotone_chain));
+				}
+			}
+		}
+	}
+}
+
+SCENARIO("Points given as separate coordinate arrays") {
+	default_random_engine gen(time(NULL));
+	uniform_real_distribution<double> dist(-1000, 1000);
+
+	GIVEN("Random points") {
+		vector<double> xs(1003);
+		vector<double> ys(xs.size());
+		vector<Point> in(xs.size());
+		for (size_t i = 0; i < xs.size(); ++i) {
+			xs[i] = dist(gen);
+			ys[i] = dist(gen);
+			in[i] = {xs[i], ys[i]};
+		}
+
+		THEN("Batched orientations match single ones") {
+			const Point a = {dist(gen), dist(gen)};
+			const Point b = {dist(gen), dist(gen)};
+			for (const size_t n : {0, 1, 2, 3, 5, 1003}) {
+				vector<double> out(n);
+				convex_hull::orientation_batch(a, b, xs.data(), ys.data(), n, out.data());
+				for (size_t i = 0; i < n; ++i) {
+					REQUIRE(out[i] == convex_hull::orientation(a, b, in[i]));
+				}
+			}
+		}
+
+		THEN("The hull is the same as for pairs") {
+			for (const bool prefilter : {false, true}) {
+				convex_hull::HullOptions options;
+				options.prefilter = prefilter;
+				convex_hull::HullStats pair_stats;
+				convex_hull::HullStats split_stats;
+				REQUIRE(convex_hull::convex_hull(xs, ys, options, &split_stats) ==
+				        convex_hull::convex_hull(in, options, &pair_stats));
+				REQUIRE(split_stats.discarded == pair_stats.discarded);
+			}
+		}
+	}
+
+	GIVEN("Arrays of different sizes") {
+		THEN("An exception is thrown") {
+			REQUIRE_THROWS(convex_hull::convex_hull(vector<double>{1, 2}, vector<double>{1}));
+		}
+	}
+}
+
+SCENARIO("Orientation is exact for nearly collinear points") {
+	// points a within a few units in the last place of (0.5, 0.5), the exact orientation of a,
+	// (12, 12) and (24, 24) is 12 * (a.x - a.y)
+	vector<Point> in = {{12, 12}, {24, 24}};
+	for (int i = 0; i < 32; ++i) {
+		for (int j = 0; j < 32; ++j) {
+			in.emplace_back(0.5 + i * 0x1p-53, 0.5 + j * 0x1p-53);
+		}
+	}
+
+	GIVEN("The orientation of every point") {
+		THEN("The sign is exact") {
+			for (size_t i = 2; i < in.size(); ++i) {
+				const double o = convex_hull::orientation(in[i], in[0], in[1]);
+				const double expected = in[i].first - in[i].second;
+				REQUIRE((o > 0) == (expected > 0));
+				REQUIRE((o < 0) == (expected < 0));
+			}
+		}
+	}
+
+	GIVEN("The hull of all points") {
+		THEN("All algorithms give the same convex hull") {
+			convex_hull::HullOptions options;
+			options.prefilter = false;
+			const vector<size_t> expected = convex_hull::convex_hull(in, options);
+			for (const auto algorithm :
+			     {convex_hull::Algorithm::monotone_chain, convex_hull::Algorithm::chan}) {
+				options.algorithm = algorithm;
+				REQUIRE(convex_hull::convex_hull(in, options) == expected);
+			}
+
+			vector<Point> polygon;
+			for (const size_t i : expected) {
+				polygon.push_back(in[i]);
+			}
+			REQUIRE(is_convex(polygon));
+		}
+	}
+}
+
+SCENARIO("Integer coordinates give the same hull as double ones") {
+	default_random_engine gen(time(NULL));
+
+	// integers of up to 32 bits are exact in double, so the exact hulls have to be equal
+	const auto same_as_double = [](const auto &in) {
+		vector<Point> as_double;
+		for (const auto &p : in) {
+			as_double.emplace_back(p.first, p.second);
+		}
+		for (const auto algorithm :
+		     {convex_hull::Algorithm::graham, convex_hull::Algorithm::monotone_chain,
+		      convex_hull::Algorithm::chan}) {
+			for (const bool prefilter : {false, true}) {
+				convex_hull::HullOptions options;
+				options.algorithm = algorithm;
+				options.prefilter = prefilter;
+				REQUIRE(convex_hull::convex_hull(in, options) ==
+				        convex_hull::convex_hull(as_double, options));
+			}
+		}
+	};
+
+	GIVEN("Points spanning the whole range of 32-bit integers") {
+		uniform_int_distribution<int32_t> dist(numeric_limits<int32_t>::min(),
+		                                       numeric_limits<int32_t>::max());
+		for (const size_t n : {100, 5000}) {
+			vector<pair<int32_t, int32_t>> in(n);
+			for (auto &p : in) {
+				p = {dist(gen), dist(gen)};
+			}
+			same_as_double(in);
+		}
+	}
+
+	GIVEN("Nearly collinear points with large coordinates") {
+		const int32_t big = numeric_limits<int32_t>::max();
+		vector<pair<int32_t, int32_t>> in = {{-big, -big + 1}, {big, big - 1}};
+		for (int32_t i = -1000; i <= 1000; ++i) {
+			in.emplace_back(i * 1000003, i * 1000003 + i % 3 - 1);
+		}
+		same_as_double(in);
+	}
+
+	GIVEN("Grid points with duplicates and collinear ones") {
+		uniform_int_distribution<int16_t> dist(-20, 20);
+		for (const size_t n : {500, 5000}) {
+			vector<pair<int16_t, int16_t>> in(n);
+			for (auto &p : in) {
+				p = {dist(gen), dist(gen)};
+			}
+			same_as_double(in);
+		}
+	}
+}
+
+// whether convex_hull() can be called with points with coordinates of type T
+template <typename T, typename = void> struct accepts_coordinate : false_type {};
+template <typename T>
+struct accepts_coordinate<
+    T, void_t<decltype(convex_hull::convex_hull(declval<const vector<pair<T, T>> &>()))>>
+    : true_type {};
+
+SCENARIO("Supported coordinate types") {
+	GIVEN("Points with double coordinates as a braced list") {
+		THEN("The non-template overload takes them") {
+			REQUIRE(convex_hull::convex_hull({{0.0, 0.0}, {1.0, 0.0}, {0.0, 1.0}}) ==
+			        vector<size_t>{0, 1, 2});
+		}
+	}
+
+	GIVEN("Other coordinate types") {
+		THEN("Only double, int16_t and int32_t are accepted at compile time") {
+			STATIC_REQUIRE(accepts_coordinate<double>::value);
+			STATIC_REQUIRE(accepts_coordinate<int16_t>::value);
+			STATIC_REQUIRE(accepts_coordinate<int32_t>::value);
+			STATIC_REQUIRE_FALSE(accepts_coordinate<float>::value);
+			STATIC_REQUIRE_FALSE(accepts_coordinate<int64_t>::value);
+		}
+	}
+}
+
 // ------- helper functions implementation -------
 
 #define x first
@@ -0,0 +1,85 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <ctime>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "../src/convex_hull_lib/convex_hull.hpp"
+#include "../src/convex_hull_lib/dynamic_hull.hpp"
+
+using namespace std;
+using convex_hull::DynamicHull;
+using Point = pair<double, double>;
+
+SCENARIO("Dynamic hull matches the hull computed from scratch") {
+	default_random_engine gen(time(NULL));
+	convex_hull::HullOptions monotone_chain;
+	monotone_chain.algorithm = convex_hull::Algorithm::monotone_chain;
+
+	GIVEN("Small sets of points") {
+		DynamicHull empty;
+		REQUIRE(empty.size() == 0);
+		REQUIRE(empty.hull().empty());
+
+		const vector<vector<Point>> sets = {
+		    {{1, 1}},
+		    {{2, 2}, {2, 2}, {2, 2}},
+		    {{0, 0}, {1, 0}},
+		    {{0, 0}, {1, 1}, {2, 2}, {3, 3}},
+		    {{0, 0}, {0, 1}, {0, 2}, {0, -1}},
+		    {{1, 1}, {2, 3}, {3, 2}, {2, 2}},
+		    {{0, 0}, {1, 0}, {2, 0}, {2, 1}, {2, 2}, {1, 2}, {0, 2}, {0, 1}, {1, 1}},
+		};
+		for (const vector<Point> &in : sets) {
+			DynamicHull hull;
+			for (size_t i = 0; i < in.size(); ++i) {
+				hull.insert(in[i], i);
+			}
+			REQUIRE(hull.size() == in.size());
+			REQUIRE(hull.hull() == convex_hull::convex_hull(in, monotone_chain));
+		}
+	}
+
+	GIVEN("Points inserted one by one") {
+		DynamicHull hull;
+		REQUIRE(hull.insert({0, 0}, 0));
+		REQUIRE(hull.insert({4, 0}, 1));
+		REQUIRE(hull.insert({0, 4}, 2));
+		REQUIRE_FALSE(hull.insert({1, 1}, 3));
+		REQUIRE_FALSE(hull.insert({2, 0}, 4));
+		REQUIRE_FALSE(hull.insert({0, 0}, 5));
+		REQUIRE(hull.hull() == vector<size_t>{0, 1, 2});
+
+		REQUIRE(hull.insert({4, 4}, 6));
+		REQUIRE(hull.hull() == vector<size_t>{0, 1, 6, 2});
+		REQUIRE(hull.insert({-1, -1}, 7));
+		REQUIRE(hull.hull() == vector<size_t>{7, 1, 6, 2});
+	}
+
+	GIVEN("Randomized sets") {
+		THEN("The hull is identical after every insertion") {
+			uniform_real_distribution<double> dist(-1000, 1000);
+			vector<Point> in;
+			DynamicHull hull;
+			for (size_t i = 0; i < 2000; ++i) {
+				in.emplace_back(dist(gen), dist(gen));
+				hull.insert(in.back(), i);
+				REQUIRE(hull.hull() == convex_hull::convex_hull(in, monotone_chain));
+			}
+		}
+
+		THEN("The hull is identical for grid points with duplicates and collinear ones") {
+			for (int i = 0; i < 20; ++i) {
+				uniform_int_distribution<int> dist(-10, 10);
+				vector<Point> in(500);
+				DynamicHull hull;
+				for (size_t j = 0; j < in.size(); ++j) {
+					in[j] = {dist(gen), dist(gen)};
+					hull.insert(in[j], j);
+				}
+				REQUIRE(hull.hull() == convex_hull::convex_hull(in, monotone_chain));
+			}
+		}
+	}
+}
@@ -0,0 +1,112 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <ctime>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "../src/bipartite_maximum_matching_lib/bipartite_maximum_matching.hpp"
+#include "../src/bipartite_maximum_matching_lib/dynamic_matcher.hpp"
+
+using bipartite_maximum_matching::DynamicMatcher;
+
+// checks that the matching uses only existing edges, is consistent with left_match/right_match
+// and has the size of a maximum matching computed from scratch
+bool is_maximum_matching(const DynamicMatcher &matcher,
+                         const std::set<std::pair<size_t, size_t>> &edges);
+
+TEST_CASE("dynamic_matcher empty", "[dynamic_matcher]") {
+	DynamicMatcher matcher;
+	REQUIRE(matcher.size() == 0);
+	REQUIRE(matcher.matching().empty());
+	REQUIRE_FALSE(matcher.remove_edge(0, 0));
+	REQUIRE_FALSE(matcher.left_match(0).has_value());
+}
+
+TEST_CASE("dynamic_matcher vertices", "[dynamic_matcher]") {
+	DynamicMatcher matcher;
+	REQUIRE(matcher.add_left_vertex() == 0);
+	REQUIRE(matcher.add_right_vertex() == 0);
+	REQUIRE(matcher.add_right_vertex() == 1);
+	REQUIRE(matcher.size() == 0);
+
+	REQUIRE(matcher.add_edge(0, 1));
+	REQUIRE_FALSE(matcher.add_edge(0, 1));
+	REQUIRE(matcher.left_match(0) == 1);
+	REQUIRE(matcher.right_match(1) == 0);
+
+	REQUIRE(matcher.add_edge(3, 2));
+	REQUIRE(matcher.left_num() == 4);
+	REQUIRE(matcher.right_num() == 3);
+	REQUIRE(matcher.size() == 2);
+}
+
+TEST_CASE("dynamic_matcher augment through both ends", "[dynamic_matcher]") {
+	// 0-0 and 1-1 matched, left 2 and right 2 stay free, adding 0-1 creates path 2-0=0-1=1-2
+	DynamicMatcher matcher({{0, 0}, {1, 1}});
+	REQUIRE(matcher.add_edge(2, 0));
+	REQUIRE(matcher.add_edge(1, 2));
+	REQUIRE(matcher.size() == 2);
+
+	REQUIRE(matcher.add_edge(0, 1));
+	REQUIRE(matcher.size() == 3);
+	REQUIRE(matcher.matching() ==
+	        std::vector<std::pair<size_t, size_t>>{{0, 1}, {1, 2}, {2, 0}});
+}
+
+TEST_CASE("dynamic_matcher remove matched edge", "[dynamic_matcher]") {
+	DynamicMatcher matcher({{0, 0}, {0, 1}, {1, 0}});
+	REQUIRE(matcher.size() == 2);
+	const size_t right = matcher.left_match(0).value();
+	REQUIRE(matcher.remove_edge(0, right));
+	REQUIRE(matcher.size() == (right == 1 ? 1 : 2));
+}
+
+TEST_CASE("dynamic_matcher randomized updates", "[dynamic_matcher]") {
+	std::default_random_engine gen(time(NULL));
+	std::uniform_int_distribution<size_t> left_dist(0, 29);
+	std::uniform_int_distribution<size_t> right_dist(0, 24);
+	std::bernoulli_distribution remove_dist(0.4);
+
+	std::set<std::pair<size_t, size_t>> edges;
+	while (edges.size() < 40) {
+		edges.insert({left_dist(gen), right_dist(gen)});
+	}
+	DynamicMatcher matcher(std::vector<std::pair<size_t, size_t>>(edges.begin(), edges.end()));
+	REQUIRE(is_maximum_matching(matcher, edges));
+
+	for (size_t i = 0; i < 2000; i++) {
+		if (remove_dist(gen) && !edges.empty()) {
+			auto it = edges.begin();
+			std::advance(it, std::uniform_int_distribution<size_t>(0, edges.size() - 1)(gen));
+			REQUIRE(matcher.remove_edge(it->first, it->second));
+			edges.erase(it);
+		} else {
+			const std::pair<size_t, size_t> edge = {left_dist(gen), right_dist(gen)};
+			REQUIRE(matcher.add_edge(edge.first, edge.second) == edges.insert(edge).second);
+		}
+		REQUIRE(is_maximum_matching(matcher, edges));
+	}
+}
+
+bool is_maximum_matching(const DynamicMatcher &matcher,
+                         const std::set<std::pair<size_t, size_t>> &edges) {
+	const auto matching = matcher.matching();
+	if (matching.size() != matcher.size()) return false;
+
+	std::set<size_t> left_used;
+	std::set<size_t> right_used;
+	for (const auto &pair : matching) {
+		if (edges.count(pair) == 0) return false;
+		if (!left_used.insert(pair.first).second || !right_used.insert(pair.second).second) {
+			return false;
+		}
+		if (matcher.left_match(pair.first) != pair.second) return false;
+		if (matcher.right_match(pair.second) != pair.first) return false;
+	}
+
+	const std::vector<std::pair<size_t, size_t>> edges_vec(edges.begin(), edges.end());
+	return matching.size() ==
+	       bipartite_maximum_matching::bipartite_maximum_matching(edges_vec).size();
+}
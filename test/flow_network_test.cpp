@@ -0,0 +1,169 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <ctime>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../src/bipartite_maximum_matching_lib/flow_network.hpp"
+
+using bipartite_maximum_matching::FlowNetwork;
+
+// checks capacity constraints and flow conservation, returns the value of the flow
+FlowNetwork::Capacity check_flow(const FlowNetwork &network, size_t source, size_t sink);
+
+TEST_CASE("flow_network no edges", "[flow_network]") {
+	FlowNetwork network(2);
+	REQUIRE(network.max_flow(0, 1) == 0);
+	REQUIRE(network.flow_edges().empty());
+}
+
+TEST_CASE("flow_network invalid arguments", "[flow_network]") {
+	FlowNetwork network(2);
+	REQUIRE_THROWS(network.add_edge(0, 2, 1));
+	REQUIRE_THROWS(network.add_edge(0, 1, -1));
+	REQUIRE_THROWS(network.max_flow(0, 0));
+	REQUIRE_THROWS(network.flow(0));
+}
+
+TEST_CASE("flow_network clrs", "[flow_network]") {
+	FlowNetwork network(6);
+	network.add_edge(0, 1, 16);
+	network.add_edge(0, 2, 13);
+	network.add_edge(2, 1, 4);
+	network.add_edge(1, 3, 12);
+	network.add_edge(3, 2, 9);
+	network.add_edge(2, 4, 14);
+	network.add_edge(4, 3, 7);
+	network.add_edge(3, 5, 20);
+	network.add_edge(4, 5, 4);
+
+	REQUIRE(network.max_flow(0, 5) == 23);
+	REQUIRE(check_flow(network, 0, 5) == 23);
+	for (const auto &edge : network.flow_edges()) {
+		REQUIRE(edge.flow > 0);
+		REQUIRE(edge.flow == network.flow(edge.id));
+	}
+}
+
+TEST_CASE("flow_network incremental", "[flow_network]") {
+	FlowNetwork network(3);
+	network.add_edge(0, 1, 5);
+	network.add_edge(1, 2, 3);
+	REQUIRE(network.max_flow(0, 2) == 3);
+
+	network.add_edge(1, 2, 10);
+	REQUIRE(network.max_flow(0, 2) == 2);
+	REQUIRE(check_flow(network, 0, 2) == 5);
+}
+
+TEST_CASE("flow_network randomized", "[flow_network]") {
+	std::default_random_engine gen(time(NULL));
+	std::uniform_int_distribution<size_t> vertex_dist(0, 199);
+	std::uniform_int_distribution<FlowNetwork::Capacity> capacity_dist(0, 1000);
+
+	FlowNetwork network(200);
+	for (size_t i = 0; i < 2000; i++) {
+		network.add_edge(vertex_dist(gen), vertex_dist(gen), capacity_dist(gen));
+	}
+	const FlowNetwork::Capacity value = network.max_flow(0, 199);
+	REQUIRE(check_flow(network, 0, 199) == value);
+
+	// the flow is maximum if the sink is not reachable in the residual network
+	REQUIRE(network.max_flow(0, 199) == 0);
+}
+
+TEST_CASE("flow_network push_relabel", "[flow_network]") {
+	std::default_random_engine gen(time(NULL));
+	std::uniform_int_distribution<FlowNetwork::Capacity> capacity_dist(0, 1000);
+
+	SECTION("clrs") {
+		FlowNetwork network(6);
+		network.add_edge(0, 1, 16);
+		network.add_edge(0, 2, 13);
+		network.add_edge(2, 1, 4);
+		network.add_edge(1, 3, 12);
+		network.add_edge(3, 2, 9);
+		network.add_edge(2, 4, 14);
+		network.add_edge(4, 3, 7);
+		network.add_edge(3, 5, 20);
+		network.add_edge(4, 5, 4);
+
+		REQUIRE(network.max_flow(0, 5, FlowNetwork::Algorithm::push_relabel) == 23);
+		REQUIRE(check_flow(network, 0, 5) == 23);
+	}
+
+	SECTION("same value as dinic") {
+		for (const size_t edges : {300, 2000, 20000}) {
+			std::uniform_int_distribution<size_t> vertex_dist(0, 199);
+			FlowNetwork dinic(200);
+			FlowNetwork push_relabel(200);
+			for (size_t i = 0; i < edges; i++) {
+				const size_t from = vertex_dist(gen);
+				const size_t to = vertex_dist(gen);
+				const FlowNetwork::Capacity capacity = capacity_dist(gen);
+				dinic.add_edge(from, to, capacity);
+				push_relabel.add_edge(from, to, capacity);
+			}
+
+			const FlowNetwork::Capacity value = dinic.max_flow(0, 199);
+			REQUIRE(push_relabel.max_flow(0, 199, FlowNetwork::Algorithm::push_relabel) == value);
+			REQUIRE(check_flow(push_relabel, 0, 199) == value);
+			REQUIRE(push_relabel.max_flow(0, 199) == 0);
+		}
+	}
+
+	SECTION("continues an existing flow") {
+		std::uniform_int_distribution<size_t> vertex_dist(0, 99);
+		FlowNetwork network(100);
+		for (size_t i = 0; i < 500; i++) {
+			network.add_edge(vertex_dist(gen), vertex_dist(gen), capacity_dist(gen));
+		}
+		FlowNetwork::Capacity value = network.max_flow(0, 99);
+		for (size_t i = 0; i < 500; i++) {
+			network.add_edge(vertex_dist(gen), vertex_dist(gen), capacity_dist(gen));
+		}
+		value += network.max_flow(0, 99, FlowNetwork::Algorithm::push_relabel);
+		REQUIRE(check_flow(network, 0, 99) == value);
+		REQUIRE(network.max_flow(0, 99) == 0);
+	}
+}
+
+TEST_CASE("flow_network benchmark", "[.][benchmark][flow_network]") {
+	std::default_random_engine gen(0);
+	std::uniform_int_distribution<FlowNetwork::Capacity> capacity_dist(0, 1000);
+
+	for (const size_t vertices : {5000, 100000}) {
+		std::uniform_int_distribution<size_t> vertex_dist(0, vertices - 1);
+		FlowNetwork network(vertices);
+		for (size_t i = 0; i < 1000000; i++) {
+			network.add_edge(vertex_dist(gen), vertex_dist(gen), capacity_dist(gen));
+		}
+
+		for (const auto algorithm :
+		     {FlowNetwork::Algorithm::dinic, FlowNetwork::Algorithm::push_relabel}) {
+			const std::string name =
+			    algorithm == FlowNetwork::Algorithm::dinic ? "dinic " : "push-relabel ";
+			BENCHMARK_ADVANCED(name + std::to_string(vertices) + " vertices")
+			(Catch::Benchmark::Chronometer meter) {
+				std::vector<FlowNetwork> copies(meter.runs(), network);
+				meter.measure(
+				    [&](int i) { return copies[i].max_flow(0, vertices - 1, algorithm); });
+			};
+		}
+	}
+}
+
+FlowNetwork::Capacity check_flow(const FlowNetwork &network, size_t source, size_t sink) {
+	std::vector<FlowNetwork::Capacity> balance(network.vertices_num(), 0);
+	for (const auto &edge : network.flow_edges()) {
+		if (edge.flow > edge.capacity) return -1;
+		balance[edge.from] -= edge.flow;
+		balance[edge.to] += edge.flow;
+	}
+	for (size_t v = 0; v < network.vertices_num(); v++) {
+		if (v != source && v != sink && balance[v] != 0) return -1;
+	}
+	return balance[sink];
+}
@@ -0,0 +1,165 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <ctime>
+#include <optional>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "../src/convex_hull_lib/convex_hull.hpp"
+#include "../src/convex_hull_lib/hull_index.hpp"
+#include "../src/convex_hull_lib/parallel_chunks.hpp"
+
+using namespace std;
+using convex_hull::HullIndex;
+using Point = pair<double, double>;
+
+// positive if c is on the left of the line from a through b
+double left_side(const Point &a, const Point &b, const Point &c) {
+	return -convex_hull::orientation(a, b, c);
+}
+
+bool contains_linear(const vector<Point> &polygon, const Point &p) {
+	if (polygon.size() == 1) return p == polygon[0];
+	if (polygon.size() == 2) {
+		return left_side(polygon[0], polygon[1], p) == 0 && min(polygon[0], polygon[1]) <= p &&
+		       p <= max(polygon[0], polygon[1]);
+	}
+	for (size_t i = 0; i < polygon.size(); ++i) {
+		if (left_side(polygon[i], polygon[(i + 1) % polygon.size()], p) < 0) return false;
+	}
+	return true;
+}
+
+SCENARIO("Hull index answers queries like linear scans") {
+	default_random_engine gen(time(NULL));
+
+	GIVEN("An empty hull") {
+		const HullIndex index({}, {});
+		REQUIRE(index.size() == 0);
+		REQUIRE_FALSE(index.contains({0, 0}));
+		REQUIRE_FALSE(index.tangents({0, 0}).has_value());
+		REQUIRE_THROWS(index.extreme({1, 0}));
+		REQUIRE_THROWS(HullIndex({{0, 0}}, {1}));
+	}
+
+	GIVEN("A square") {
+		const vector<Point> in = {{0, 0}, {2, 0}, {2, 2}, {0, 2}, {1, 1}};
+		const HullIndex index(in, convex_hull::convex_hull(in));
+		REQUIRE(index.size() == 4);
+		REQUIRE(index.contains({1, 1}));
+		REQUIRE(index.contains({2, 1}));
+		REQUIRE(index.contains({0, 0}));
+		REQUIRE_FALSE(index.contains({3, 1}));
+		REQUIRE_FALSE(index.contains({-1, -1}));
+
+		REQUIRE(index.extreme({1, 1}) == 2);
+		REQUIRE(index.extreme({-1, -1}) == 0);
+		REQUIRE(index.extreme({1, -1}) == 1);
+
+		REQUIRE(index.tangents({1, -2}) == HullIndex::Tangents{0, 1});
+		REQUIRE(index.tangents({4, 0}) == HullIndex::Tangents{1, 2});
+		REQUIRE(index.tangents({-1, -1}) == HullIndex::Tangents{3, 1});
+		REQUIRE_FALSE(index.tangents({1, 1}).has_value());
+		REQUIRE_FALSE(index.tangents({2, 2}).has_value());
+	}
+
+	GIVEN("Random grid points") {
+		// integer coordinates, so that the dot products of the linear scan are exact
+		for (const int range : {0, 1, 3, 30, 1000}) {
+			uniform_int_distribution<int> dist(-range, range);
+			uniform_int_distribution<int> query_dist(-2 * range - 1, 2 * range + 1);
+			vector<Point> in(200);
+			for (Point &p : in) {
+				p = {dist(gen), dist(gen)};
+			}
+			const vector<size_t> hull = convex_hull::convex_hull(in);
+			const HullIndex index(in, hull);
+			vector<Point> polygon;
+			for (const size_t i : hull) {
+				polygon.push_back(in[i]);
+			}
+
+			vector<Point> queries(2000);
+			for (Point &q : queries) {
+				q = {query_dist(gen), query_dist(gen)};
+			}
+
+			THEN("Containment matches the linear scan") {
+				vector<size_t> expected;
+				for (size_t i = 0; i < queries.size(); ++i) {
+					REQUIRE(index.contains(queries[i]) == contains_linear(polygon, queries[i]));
+					if (contains_linear(polygon, queries[i])) expected.push_back(i);
+				}
+				REQUIRE(index.inside(queries) == expected);
+				REQUIRE(index.inside(queries, 4) == expected);
+			}
+
+			THEN("Extreme vertices have the largest dot product") {
+				for (const Point &d : queries) {
+					double best = polygon[0].first * d.first + polygon[0].second * d.second;
+					for (const Point &p : polygon) {
+						best = max(best, p.first * d.first + p.second * d.second);
+					}
+					const Point &p = in[index.extreme(d)];
+					REQUIRE(p.first * d.first + p.second * d.second == best);
+				}
+				REQUIRE(index.extreme(queries, 3) == index.extreme(queries));
+			}
+
+			THEN("Tangents leave the hull on one side") {
+				for (const Point &q : queries) {
+					const optional<HullIndex::Tangents> tangents = index.tangents(q);
+					REQUIRE(tangents.has_value() == !contains_linear(polygon, q));
+					if (!tangents) continue;
+
+					const Point &right = in[tangents->first];
+					const Point &left = in[tangents->second];
+					for (const Point &p : polygon) {
+						REQUIRE(left_side(q, right, p) <= 0);
+						REQUIRE(left_side(q, left, p) >= 0);
+						if (left_side(q, right, p) == 0) {
+							REQUIRE(convex_hull::distance_sq(q, right) <=
+							        convex_hull::distance_sq(q, p));
+						}
+						if (left_side(q, left, p) == 0) {
+							REQUIRE(convex_hull::distance_sq(q, left) <=
+							        convex_hull::distance_sq(q, p));
+						}
+					}
+				}
+				REQUIRE(index.tangents(queries, 2) == index.tangents(queries));
+			}
+		}
+	}
+
+	GIVEN("More queries than fit in one parallel chunk") {
+		uniform_int_distribution<int> dist(-1000, 1000);
+		uniform_int_distribution<int> query_dist(-2001, 2001);
+		vector<Point> in(1000);
+		for (Point &p : in) {
+			p = {dist(gen), dist(gen)};
+		}
+		const HullIndex index(in, convex_hull::convex_hull(in));
+		vector<Point> queries(2 * convex_hull::PARALLEL_CHUNK + 1000);
+		for (Point &q : queries) {
+			q = {query_dist(gen), query_dist(gen)};
+		}
+
+		THEN("Batched queries on several threads match single queries") {
+			vector<size_t> inside;
+			vector<size_t> extreme;
+			vector<optional<HullIndex::Tangents>> tangents;
+			for (size_t i = 0; i < queries.size(); ++i) {
+				if (index.contains(queries[i])) inside.push_back(i);
+				extreme.push_back(index.extreme(queries[i]));
+				tangents.push_back(index.tangents(queries[i]));
+			}
+			for (const size_t threads : {2, 4}) {
+				REQUIRE(index.inside(queries, threads) == inside);
+				REQUIRE(index.extreme(queries, threads) == extreme);
+				REQUIRE(index.tangents(queries, threads) == tangents);
+			}
+		}
+	}
+}
@@ -0,0 +1,166 @@
+#include <algorithm>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <cstddef>
+#include <ctime>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../src/convex_hull_lib/convex_hull.hpp"
+#include "../src/convex_hull_lib/rotating_calipers.hpp"
+
+using namespace std;
+using Point = pair<double, double>;
+
+// ------- O(h^2) baselines over the hull vertices -------
+
+double dot(const Point &a, const Point &b, const Point &p) {
+	return (b.first - a.first) * (p.first - a.first) +
+	       (b.second - a.second) * (p.second - a.second);
+}
+
+double brute_force_diameter(const vector<Point> &polygon) {
+	double best = 0;
+	for (const Point &a : polygon) {
+		for (const Point &b : polygon) {
+			best = max(best, convex_hull::distance_sq(a, b));
+		}
+	}
+	return sqrt(best);
+}
+
+double brute_force_width(const vector<Point> &polygon) {
+	double best = INFINITY;
+	for (size_t i = 0; i < polygon.size(); ++i) {
+		const Point &a = polygon[i];
+		const Point &b = polygon[(i + 1) % polygon.size()];
+		double height = 0;
+		for (const Point &p : polygon) {
+			height = max(height, -convex_hull::orientation(a, b, p));
+		}
+		best = min(best, height / sqrt(convex_hull::distance_sq(a, b)));
+	}
+	return best;
+}
+
+double brute_force_rectangle_area(const vector<Point> &polygon) {
+	double best = INFINITY;
+	for (size_t i = 0; i < polygon.size(); ++i) {
+		const Point &a = polygon[i];
+		const Point &b = polygon[(i + 1) % polygon.size()];
+		double height = 0;
+		double low = 0;
+		double high = 0;
+		for (const Point &p : polygon) {
+			height = max(height, -convex_hull::orientation(a, b, p));
+			low = min(low, dot(a, b, p));
+			high = max(high, dot(a, b, p));
+		}
+		best = min(best, (high - low) * height / convex_hull::distance_sq(a, b));
+	}
+	return best;
+}
+
+SCENARIO("Rotating calipers match the brute force") {
+	default_random_engine gen(time(NULL));
+
+	GIVEN("Degenerate hulls") {
+		REQUIRE_THROWS(convex_hull::diameter({}, {}));
+		REQUIRE_THROWS(convex_hull::width({{0, 0}}, {1}));
+
+		const vector<Point> in = {{1, 2}, {4, 6}};
+		REQUIRE(convex_hull::diameter(in, {0}).distance == 0);
+		REQUIRE(convex_hull::width(in, {0}).width == 0);
+		REQUIRE(convex_hull::min_area_rectangle(in, {0}).area == 0);
+
+		const convex_hull::Diameter diameter = convex_hull::diameter(in, {0, 1});
+		REQUIRE(diameter.distance == 5);
+		REQUIRE(min(diameter.first, diameter.second) == 0);
+		REQUIRE(max(diameter.first, diameter.second) == 1);
+		REQUIRE(convex_hull::width(in, {0, 1}).width == 0);
+		REQUIRE(convex_hull::min_area_rectangle(in, {0, 1}).area == 0);
+	}
+
+	GIVEN("A rectangle") {
+		const vector<Point> in = {{0, 0}, {4, 0}, {4, 3}, {0, 3}, {2, 1}};
+		const vector<size_t> hull = convex_hull::convex_hull(in);
+		REQUIRE(convex_hull::diameter(in, hull).distance == 5);
+
+		const convex_hull::Width width = convex_hull::width(in, hull);
+		REQUIRE(width.width == 3);
+		REQUIRE(in[width.edge_start].second == in[width.edge_end].second);
+		REQUIRE(abs(in[width.vertex].second - in[width.edge_start].second) == 3);
+
+		const convex_hull::BoundingRectangle rectangle = convex_hull::min_area_rectangle(in, hull);
+		REQUIRE(rectangle.area == 12);
+		vector<Point> corners(rectangle.corners.begin(), rectangle.corners.end());
+		sort(corners.begin(), corners.end());
+		REQUIRE(corners == vector<Point>{{0, 0}, {0, 3}, {4, 0}, {4, 3}});
+	}
+
+	GIVEN("Random grid points") {
+		// integer coordinates, so that the areas and dot products of both methods are exact
+		for (const int range : {2, 10, 1000}) {
+			uniform_int_distribution<int> dist(-range, range);
+			for (int i = 0; i < 20; ++i) {
+				vector<Point> in(100);
+				for (Point &p : in) {
+					p = {dist(gen), dist(gen)};
+				}
+				const vector<size_t> hull = convex_hull::convex_hull(in);
+				vector<Point> polygon;
+				for (const size_t j : hull) {
+					polygon.push_back(in[j]);
+				}
+
+				const convex_hull::Diameter diameter = convex_hull::diameter(in, hull);
+				REQUIRE(diameter.distance == brute_force_diameter(polygon));
+				REQUIRE(sqrt(convex_hull::distance_sq(in[diameter.first], in[diameter.second])) ==
+				        diameter.distance);
+
+				REQUIRE(convex_hull::width(in, hull).width == brute_force_width(polygon));
+
+				const convex_hull::BoundingRectangle rectangle =
+				    convex_hull::min_area_rectangle(in, hull);
+				REQUIRE(rectangle.area == brute_force_rectangle_area(polygon));
+				const auto &c = rectangle.corners;
+				const double sides = sqrt(convex_hull::distance_sq(c[0], c[1]) *
+				                          convex_hull::distance_sq(c[1], c[2]));
+				REQUIRE(abs(sides - rectangle.area) <= 1e-9 * max(1.0, rectangle.area));
+				for (const Point &p : polygon) {
+					for (size_t k = 0; k < c.size(); ++k) {
+						const double side = -convex_hull::orientation(c[k], c[(k + 1) % 4], p);
+						REQUIRE(side >= -1e-9 * max(1.0, rectangle.area));
+					}
+				}
+			}
+		}
+	}
+}
+
+TEST_CASE("rotating_calipers benchmark", "[.][benchmark][convex_hull]") {
+	// points on a circle are all hull vertices
+	default_random_engine gen(0);
+	uniform_real_distribution<double> angle(0, 2 * acos(-1.0));
+	vector<Point> in(10000);
+	for (Point &p : in) {
+		const double a = angle(gen);
+		p = {1000 * cos(a), 1000 * sin(a)};
+	}
+	const vector<size_t> hull = convex_hull::convex_hull(in);
+	vector<Point> polygon;
+	for (const size_t i : hull) {
+		polygon.push_back(in[i]);
+	}
+	const string size = " " + to_string(hull.size()) + " vertices";
+
+	BENCHMARK("diameter calipers" + size) { return convex_hull::diameter(in, hull); };
+	BENCHMARK("diameter brute force" + size) { return brute_force_diameter(polygon); };
+	BENCHMARK("width calipers" + size) { return convex_hull::width(in, hull); };
+	BENCHMARK("width brute force" + size) { return brute_force_width(polygon); };
+	BENCHMARK("rectangle calipers" + size) { return convex_hull::min_area_rectangle(in, hull); };
+	BENCHMARK("rectangle brute force" + size) { return brute_force_rectangle_area(polygon); };
+}
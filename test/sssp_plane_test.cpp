@@ -1,7 +1,11 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_message.hpp>
 #include <catch2/catch_test_macros.hpp>
 #include <cmath>
 #include <cstddef>
+#include <random>
 #include <set>
+#include <string>
 #include <vector>
 
 #include "../src/sssp_plane_lib/sssp_plane.hpp"
@@ -80,6 +84,247 @@ TEST_CASE("sssp_plane unreachable_reverse", "[sssp_plane]") {
 	REQUIRE(result.empty());
 }
 
+TEST_CASE("sssp_plane destination out of range", "[sssp_plane]") {
+	REQUIRE_THROWS(sssp_plane::sssp_plane({{0, 0}}, {}, 0, {1}));
+}
+
+// jittered grid with edges between neighbours in both directions, some of them missing
+void road_graph(std::size_t side, std::mt19937 &gen, std::vector<sssp_plane::Point> &points,
+                std::vector<sssp_plane::Edge> &edges) {
+	std::uniform_real_distribution<double> jitter(-0.3, 0.3);
+	std::bernoulli_distribution missing(0.2);
+	points.clear();
+	edges.clear();
+	for (std::size_t i = 0; i < side; ++i) {
+		for (std::size_t j = 0; j < side; ++j) {
+			points.emplace_back(i + jitter(gen), j + jitter(gen));
+		}
+	}
+	for (std::size_t i = 0; i < side; ++i) {
+		for (std::size_t j = 0; j < side; ++j) {
+			const std::size_t v = i * side + j;
+			if (i + 1 < side && !missing(gen)) {
+				edges.emplace_back(v, v + side);
+				edges.emplace_back(v + side, v);
+			}
+			if (j + 1 < side && !missing(gen)) {
+				edges.emplace_back(v, v + 1);
+				edges.emplace_back(v + 1, v);
+			}
+		}
+	}
+}
+
+TEST_CASE("sssp_plane a_star matches dijkstra", "[sssp_plane]") {
+	std::mt19937 gen(42);
+	const std::size_t side = 30;
+	std::vector<sssp_plane::Point> points;
+	std::vector<sssp_plane::Edge> edges;
+	std::uniform_int_distribution<std::size_t> vertex(0, side * side - 1);
+	sssp_plane::SSSP_Options dijkstra;
+	dijkstra.algorithm = sssp_plane::Algorithm::dijkstra;
+	sssp_plane::SSSP_Options a_star;
+	a_star.algorithm = sssp_plane::Algorithm::a_star;
+
+	for (int i = 0; i < 20; ++i) {
+		road_graph(side, gen, points, edges);
+		const std::size_t start = vertex(gen);
+		std::vector<std::size_t> destinations(i % 4 + 1);
+		for (auto &destination : destinations) {
+			destination = vertex(gen);
+		}
+
+		auto expected = sssp_plane::sssp_plane(points, edges, start, destinations, dijkstra);
+		auto result = sssp_plane::sssp_plane(points, edges, start, destinations, a_star);
+		REQUIRE(result.size() == expected.size());
+		for (std::size_t j = 0; j < result.size(); ++j) {
+			REQUIRE(result[j].destination == expected[j].destination);
+			REQUIRE(std::abs(result[j].length - expected[j].length) <= 1e-9);
+			REQUIRE(is_valid_path(result[j], points, edges, start));
+		}
+	}
+}
+
+TEST_CASE("sssp_plane a_star unreachable", "[sssp_plane]") {
+	std::vector<sssp_plane::Point> points = {{0, 0}, {1, 0}, {2, 0}};
+	std::vector<sssp_plane::Edge> edges = {{0, 1}, {2, 1}};
+	sssp_plane::SSSP_Options a_star;
+	a_star.algorithm = sssp_plane::Algorithm::a_star;
+
+	auto result = sssp_plane::sssp_plane(points, edges, 0, {2, 1, 1}, a_star);
+	std::vector<sssp_plane::SSSP_Path> expected = {sssp_plane::SSSP_Path(1, {0, 1}, 1),
+	                                               sssp_plane::SSSP_Path(1, {0, 1}, 1)};
+
+	REQUIRE(result == expected);
+}
+
+TEST_CASE("sssp_plane stops once destinations are settled", "[sssp_plane]") {
+	std::vector<sssp_plane::Point> points = {{0, 0}, {1, 0}, {2, 0}, {3, 0}, {4, 0}};
+	std::vector<sssp_plane::Edge> edges = {{0, 1}, {1, 2}, {2, 3}, {3, 4}};
+	sssp_plane::SSSP_Options dijkstra;
+	dijkstra.algorithm = sssp_plane::Algorithm::dijkstra;
+	sssp_plane::SSSP_Stats stats;
+
+	auto result = sssp_plane::sssp_plane(points, edges, 0, {1}, dijkstra, &stats);
+	REQUIRE(result == std::vector<sssp_plane::SSSP_Path>{sssp_plane::SSSP_Path(1, {0, 1}, 1)});
+	REQUIRE(stats.settled == 2);
+
+	result = sssp_plane::sssp_plane(points, edges, 0, {2, 1}, dijkstra, &stats);
+	REQUIRE(result.size() == 2);
+	REQUIRE(stats.settled == 3);
+
+	sssp_plane::sssp_plane(points, edges, 0, {}, dijkstra, &stats);
+	REQUIRE(stats.settled == 0);
+
+	sssp_plane::sssp_plane(points, edges, 2, {0}, dijkstra, &stats);
+	REQUIRE(stats.settled == 3);
+}
+
+TEST_CASE("sssp_plane a_star settles fewer vertices", "[sssp_plane]") {
+	std::mt19937 gen(7);
+	const std::size_t side = 50;
+	std::vector<sssp_plane::Point> points;
+	std::vector<sssp_plane::Edge> edges;
+	road_graph(side, gen, points, edges);
+	sssp_plane::SSSP_Options dijkstra;
+	dijkstra.algorithm = sssp_plane::Algorithm::dijkstra;
+	sssp_plane::SSSP_Options a_star;
+	a_star.algorithm = sssp_plane::Algorithm::a_star;
+	sssp_plane::SSSP_Stats dijkstra_stats;
+	sssp_plane::SSSP_Stats a_star_stats;
+
+	// from one corner to the middle of the opposite side
+	const std::size_t start = 0;
+	const std::size_t destination = (side - 1) * side + side / 2;
+	auto expected = sssp_plane::sssp_plane(points, edges, start, {destination}, dijkstra,
+	                                       &dijkstra_stats);
+	auto result =
+	    sssp_plane::sssp_plane(points, edges, start, {destination}, a_star, &a_star_stats);
+	REQUIRE(result.size() == expected.size());
+	REQUIRE(a_star_stats.settled > 0);
+	REQUIRE(a_star_stats.settled < dijkstra_stats.settled);
+}
+
+TEST_CASE("plane_graph invalid edge", "[sssp_plane]") {
+	REQUIRE_THROWS(sssp_plane::PlaneGraph({{0, 0}}, {{0, 1}}));
+}
+
+TEST_CASE("plane_graph repeated queries match sssp_plane", "[sssp_plane]") {
+	std::mt19937 gen(3);
+	const std::size_t side = 30;
+	std::vector<sssp_plane::Point> points;
+	std::vector<sssp_plane::Edge> edges;
+	road_graph(side, gen, points, edges);
+	const sssp_plane::PlaneGraph graph(points, edges);
+	const sssp_plane::BasicPlaneGraph<float> float_graph(points, edges);
+	REQUIRE(graph.size() == points.size());
+	REQUIRE_THROWS(graph.query(points.size(), {}));
+	REQUIRE_THROWS(graph.query(0, {points.size()}));
+
+	std::uniform_int_distribution<std::size_t> vertex(0, side * side - 1);
+	for (int i = 0; i < 20; ++i) {
+		const std::size_t start = vertex(gen);
+		std::vector<std::size_t> destinations(i % 2 == 0 ? 3 : 20);
+		for (auto &destination : destinations) {
+			destination = vertex(gen);
+		}
+
+		auto expected = sssp_plane::sssp_plane(points, edges, start, destinations);
+		REQUIRE(graph.query(start, destinations) == expected);
+		auto result = float_graph.query(start, destinations);
+		REQUIRE(result.size() == expected.size());
+		for (std::size_t j = 0; j < result.size(); ++j) {
+			REQUIRE(result[j].destination == expected[j].destination);
+			REQUIRE(result[j].length >= expected[j].length - 1e-9);
+			REQUIRE(result[j].length <= expected[j].length * (1 + 1e-6));
+		}
+	}
+}
+
+TEST_CASE("sssp_plane queues give the same distances", "[sssp_plane]") {
+	std::mt19937 gen(11);
+	const std::size_t side = 30;
+	std::vector<sssp_plane::Point> points;
+	std::vector<sssp_plane::Edge> edges;
+	std::uniform_int_distribution<std::size_t> vertex(0, side * side - 1);
+
+	for (int i = 0; i < 10; ++i) {
+		road_graph(side, gen, points, edges);
+		const sssp_plane::PlaneGraph graph(points, edges);
+		const std::size_t start = vertex(gen);
+		std::vector<std::size_t> destinations(i % 2 == 0 ? 2 : 30);
+		for (auto &destination : destinations) {
+			destination = vertex(gen);
+		}
+
+		for (const auto algorithm :
+		     {sssp_plane::Algorithm::dijkstra, sssp_plane::Algorithm::a_star}) {
+			sssp_plane::SSSP_Options options;
+			options.algorithm = algorithm;
+			options.queue = sssp_plane::Queue::binary_heap;
+			const auto expected = graph.query(start, destinations, options);
+			for (const auto queue :
+			     {sssp_plane::Queue::indexed_heap, sssp_plane::Queue::radix_heap}) {
+				options.queue = queue;
+				sssp_plane::SSSP_Stats stats;
+				const auto result = graph.query(start, destinations, options, &stats);
+				REQUIRE(result.size() == expected.size());
+				for (std::size_t j = 0; j < result.size(); ++j) {
+					REQUIRE(result[j].destination == expected[j].destination);
+					REQUIRE(std::abs(result[j].length - expected[j].length) <= 1e-9);
+					REQUIRE(is_valid_path(result[j], points, edges, start));
+				}
+				REQUIRE(stats.pops >= stats.settled);
+				REQUIRE(stats.pushes >= stats.pops);
+				REQUIRE(stats.peak_queue_bytes > 0);
+				if (queue == sssp_plane::Queue::indexed_heap) {
+					// no outdated entries
+					REQUIRE(stats.pops == stats.settled);
+				} else {
+					REQUIRE(stats.decrease_keys == 0);
+				}
+			}
+		}
+	}
+}
+
+TEST_CASE("sssp_plane benchmark", "[.][benchmark][sssp_plane]") {
+	std::mt19937 gen(0);
+	const std::size_t side = 500;
+	std::vector<sssp_plane::Point> points;
+	std::vector<sssp_plane::Edge> edges;
+	road_graph(side, gen, points, edges);
+	const sssp_plane::PlaneGraph graph(points, edges);
+	// from the centre to a vertex halfway to a corner, searched by A*, and to every vertex on the
+	// border, searched by Dijkstra's algorithm
+	const std::size_t source = side / 2 * side + side / 2;
+	std::vector<std::vector<std::size_t>> queries = {{side / 4 * side + side / 4}, {}};
+	for (std::size_t i = 0; i < side; ++i) {
+		queries[1].insert(queries[1].end(),
+		                  {i, i * side, i * side + side - 1, (side - 1) * side + i});
+	}
+
+	for (const auto queue : {sssp_plane::Queue::binary_heap, sssp_plane::Queue::indexed_heap,
+	                         sssp_plane::Queue::radix_heap}) {
+		sssp_plane::SSSP_Options options;
+		options.queue = queue;
+		const std::string name = queue == sssp_plane::Queue::binary_heap    ? "binary heap, "
+		                         : queue == sssp_plane::Queue::indexed_heap ? "indexed heap, "
+		                                                                    : "radix heap, ";
+		for (const auto &destinations : queries) {
+			const std::string count = std::to_string(destinations.size());
+			sssp_plane::SSSP_Stats stats;
+			graph.query(source, destinations, options, &stats);
+			WARN(name << count << " destinations: " << stats.settled << " settled, "
+			          << stats.pushes + stats.decrease_keys + stats.pops << " queue operations, "
+			          << stats.peak_queue_bytes / 1024 << " KiB peak queue memory");
+			BENCHMARK(name + count + " destinations") {
+				return graph.query(source, destinations, options);
+			};
+		}
+	}
+}
+
 double euclidian_distance(const sssp_plane::Point &a, const sssp_plane::Point &b) {
 	double dx = a.first - b.first;
 	double dy = a.second - b.second;
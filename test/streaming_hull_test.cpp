@@ -0,0 +1,77 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <ctime>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "../src/convex_hull_lib/convex_hull.hpp"
+#include "../src/convex_hull_lib/streaming_hull.hpp"
+
+using namespace std;
+using convex_hull::StreamingHull;
+using Point = pair<double, double>;
+
+SCENARIO("Streaming hull matches the hull computed from scratch") {
+	default_random_engine gen(time(NULL));
+	convex_hull::HullOptions monotone_chain;
+	monotone_chain.algorithm = convex_hull::Algorithm::monotone_chain;
+
+	GIVEN("An empty stream") {
+		StreamingHull hull;
+		hull.finish();
+		REQUIRE(hull.size() == 0);
+		REQUIRE(hull.hull().empty());
+		REQUIRE(hull.vertices().empty());
+	}
+
+	GIVEN("Points in a square") {
+		uniform_real_distribution<double> dist(-1000, 1000);
+		vector<Point> in(20000);
+		for (Point &p : in) {
+			p = {dist(gen), dist(gen)};
+		}
+		const vector<size_t> expected = convex_hull::convex_hull(in, monotone_chain);
+
+		for (const size_t chunk : {1, 7, 1000, 20000, 50000}) {
+			StreamingHull hull(chunk, monotone_chain);
+			for (const Point &p : in) {
+				hull.add_point(p);
+			}
+			hull.finish();
+			REQUIRE(hull.size() == in.size());
+			REQUIRE(hull.hull() == expected);
+			for (size_t i = 0; i < expected.size(); ++i) {
+				REQUIRE(hull.vertices()[i] == in[expected[i]]);
+			}
+		}
+	}
+
+	GIVEN("Grid points with duplicates and collinear ones") {
+		for (int i = 0; i < 20; ++i) {
+			uniform_int_distribution<int> dist(-10, 10);
+			vector<Point> in(500);
+			StreamingHull hull(64, monotone_chain);
+			for (Point &p : in) {
+				p = {dist(gen), dist(gen)};
+				hull.add_point(p);
+			}
+			hull.finish();
+			REQUIRE(hull.hull() == convex_hull::convex_hull(in, monotone_chain));
+		}
+	}
+
+	GIVEN("Grid points with duplicates and the default options") {
+		for (int i = 0; i < 50; ++i) {
+			uniform_int_distribution<int> dist(-10, 10);
+			vector<Point> in(500);
+			StreamingHull hull(64);
+			for (Point &p : in) {
+				p = {dist(gen), dist(gen)};
+				hull.add_point(p);
+			}
+			hull.finish();
+			REQUIRE(hull.hull() == convex_hull::convex_hull(in));
+		}
+	}
+}
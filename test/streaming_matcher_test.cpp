@@ -0,0 +1,122 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <ctime>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "../src/bipartite_maximum_matching_lib/bipartite_maximum_matching.hpp"
+#include "../src/bipartite_maximum_matching_lib/streaming_matcher.hpp"
+
+using bipartite_maximum_matching::StreamingMatcher;
+
+// checks that the matching uses only given edges and no vertex twice
+bool is_valid_matching(const std::vector<std::pair<size_t, size_t>> &matching,
+                       const std::vector<std::pair<size_t, size_t>> &edges);
+
+// feeds all edges to the matcher and finishes the pass
+bool stream_pass(StreamingMatcher &matcher, const std::vector<std::pair<size_t, size_t>> &edges);
+
+std::vector<std::pair<size_t, size_t>> generate_random_edges(size_t left_num, size_t right_num,
+                                                             size_t edge_num, unsigned seed);
+
+TEST_CASE("streaming_matcher empty", "[streaming_matcher]") {
+	StreamingMatcher matcher;
+	REQUIRE_FALSE(matcher.finish_pass());
+	REQUIRE(matcher.passes() == 1);
+	REQUIRE(matcher.size() == 0);
+	REQUIRE(matcher.matching().empty());
+}
+
+TEST_CASE("streaming_matcher single pass is maximal", "[streaming_matcher]") {
+	const auto seed = static_cast<unsigned>(time(NULL));
+	for (unsigned i = 0; i < 20; i++) {
+		auto edges = generate_random_edges(500, 400, 1500, seed + i);
+		StreamingMatcher matcher;
+		stream_pass(matcher, edges);
+		auto result = matcher.matching();
+		REQUIRE(is_valid_matching(result, edges));
+		REQUIRE(result.size() == matcher.size());
+
+		std::set<size_t> left_matched;
+		std::set<size_t> right_matched;
+		for (const auto &pair : result) {
+			left_matched.insert(pair.first);
+			right_matched.insert(pair.second);
+		}
+		for (const auto &edge : edges) {
+			REQUIRE((left_matched.count(edge.first) == 1 || right_matched.count(edge.second) == 1));
+		}
+		auto maximum = bipartite_maximum_matching::bipartite_maximum_matching(edges);
+		REQUIRE(2 * result.size() >= maximum.size());
+	}
+}
+
+TEST_CASE("streaming_matcher passes reach maximum", "[streaming_matcher]") {
+	const auto seed = static_cast<unsigned>(time(NULL));
+	for (unsigned i = 0; i < 20; i++) {
+		auto edges = generate_random_edges(500, 400, 1200, seed + i);
+		StreamingMatcher matcher;
+		size_t previous = 0;
+		while (stream_pass(matcher, edges)) {
+			REQUIRE(matcher.size() >= previous);
+			previous = matcher.size();
+		}
+		REQUIRE(is_valid_matching(matcher.matching(), edges));
+		auto maximum = bipartite_maximum_matching::bipartite_maximum_matching(edges);
+		REQUIRE(matcher.size() == maximum.size());
+	}
+}
+
+TEST_CASE("streaming_matcher long augmenting path", "[streaming_matcher]") {
+	// greedy takes i-i for i < n, the only maximum matching is i-(i+1) plus n-0
+	const size_t n = 50;
+	std::vector<std::pair<size_t, size_t>> edges;
+	for (size_t i = 0; i < n; i++) {
+		edges.emplace_back(i, i);
+		edges.emplace_back(i, i + 1);
+	}
+	edges.emplace_back(n, 0);
+
+	StreamingMatcher matcher;
+	stream_pass(matcher, edges);
+	REQUIRE(matcher.size() == n);
+	while (stream_pass(matcher, edges)) {
+	}
+	REQUIRE(matcher.size() == n + 1);
+	REQUIRE(matcher.passes() > n);
+}
+
+bool stream_pass(StreamingMatcher &matcher, const std::vector<std::pair<size_t, size_t>> &edges) {
+	for (const auto &edge : edges) {
+		matcher.add_edge(edge.first, edge.second);
+	}
+	return matcher.finish_pass();
+}
+
+std::vector<std::pair<size_t, size_t>> generate_random_edges(size_t left_num, size_t right_num,
+                                                             size_t edge_num, unsigned seed) {
+	std::default_random_engine gen(seed);
+	std::uniform_int_distribution<size_t> left_dist(0, left_num - 1);
+	std::uniform_int_distribution<size_t> right_dist(0, right_num - 1);
+
+	std::vector<std::pair<size_t, size_t>> result;
+	for (size_t i = 0; i < edge_num; i++) {
+		result.emplace_back(left_dist(gen), right_dist(gen));
+	}
+	return result;
+}
+
+bool is_valid_matching(const std::vector<std::pair<size_t, size_t>> &matching,
+                       const std::vector<std::pair<size_t, size_t>> &edges) {
+	std::set<std::pair<size_t, size_t>> edge_set(edges.begin(), edges.end());
+	std::set<size_t> left_used;
+	std::set<size_t> right_used;
+	for (const auto &pair : matching) {
+		if (edge_set.count(pair) == 0) return false;
+		if (!left_used.insert(pair.first).second) return false;
+		if (!right_used.insert(pair.second).second) return false;
+	}
+	return true;
+}
@@ -0,0 +1,122 @@
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <ctime>
+#include <limits>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "../src/bipartite_maximum_matching_lib/weighted_assignment.hpp"
+
+using bipartite_maximum_matching::WeightedPair;
+
+// returns the total weight of the matching or -infinity if it is not a valid matching
+double matching_weight(const std::vector<std::pair<size_t, size_t>> &matching,
+                       const std::vector<WeightedPair> &pairs);
+
+// exhaustive search over subsets of right vertices, for small graphs only
+double maximum_matching_weight(const std::vector<WeightedPair> &pairs, size_t left_num,
+                               size_t right_num);
+
+std::vector<WeightedPair> generate_random_weighted_graph(size_t left_num, size_t right_num,
+                                                         size_t edge_num, unsigned seed);
+
+TEST_CASE("weighted_assignment empty", "[weighted_assignment]") {
+	REQUIRE(bipartite_maximum_matching::weighted_assignment({}).empty());
+}
+
+TEST_CASE("weighted_assignment prefers heavier pairs", "[weighted_assignment]") {
+	// both perfect matchings have 2 pairs, 0-1 and 1-0 weigh more
+	std::vector<WeightedPair> in = {{0, 0, 1}, {0, 1, 5}, {1, 0, 5}, {1, 1, 1}};
+	auto result = bipartite_maximum_matching::weighted_assignment(in);
+	REQUIRE(result == std::vector<std::pair<size_t, size_t>>{{0, 1}, {1, 0}});
+}
+
+TEST_CASE("weighted_assignment does not force cardinality", "[weighted_assignment]") {
+	// matching 0-0 alone is better than 0-1 and 1-0 together
+	std::vector<WeightedPair> in = {{0, 0, 10}, {0, 1, 2}, {1, 0, 3}, {2, 2, -1}};
+	auto result = bipartite_maximum_matching::weighted_assignment(in);
+	REQUIRE(result == std::vector<std::pair<size_t, size_t>>{{0, 0}});
+}
+
+TEST_CASE("weighted_assignment randomized", "[weighted_assignment]") {
+	const auto seed = static_cast<unsigned>(time(NULL));
+	for (unsigned i = 0; i < 30; i++) {
+		std::vector<WeightedPair> in = generate_random_weighted_graph(8, 7, 20, seed + i);
+		auto result = bipartite_maximum_matching::weighted_assignment(in);
+		REQUIRE(matching_weight(result, in) == maximum_matching_weight(in, 8, 7));
+	}
+}
+
+TEST_CASE("weighted_assignment parallel", "[weighted_assignment]") {
+	std::vector<WeightedPair> in =
+	    generate_random_weighted_graph(2000, 2000, 10000, static_cast<unsigned>(time(NULL)));
+	bipartite_maximum_matching::AssignmentOptions options;
+	auto sequential = bipartite_maximum_matching::weighted_assignment(in, options);
+	options.threads = 4;
+	auto parallel = bipartite_maximum_matching::weighted_assignment(in, options);
+	REQUIRE(matching_weight(sequential, in) != -std::numeric_limits<double>::infinity());
+	REQUIRE(parallel == sequential);
+}
+
+std::vector<WeightedPair> generate_random_weighted_graph(size_t left_num, size_t right_num,
+                                                         size_t edge_num, unsigned seed) {
+	std::default_random_engine gen(seed);
+	std::uniform_int_distribution<size_t> left_dist(0, left_num - 1);
+	std::uniform_int_distribution<size_t> right_dist(0, right_num - 1);
+	std::uniform_int_distribution<int> weight_dist(-10, 100);
+
+	std::set<std::pair<size_t, size_t>> edges;
+	while (edges.size() < edge_num) {
+		edges.insert({left_dist(gen), right_dist(gen)});
+	}
+
+	std::vector<WeightedPair> result;
+	for (const auto &edge : edges) {
+		result.push_back({edge.first, edge.second, static_cast<double>(weight_dist(gen))});
+	}
+	return result;
+}
+
+double matching_weight(const std::vector<std::pair<size_t, size_t>> &matching,
+                       const std::vector<WeightedPair> &pairs) {
+	std::set<size_t> left_used;
+	std::set<size_t> right_used;
+	double result = 0;
+	for (const auto &pair : matching) {
+		if (!left_used.insert(pair.first).second || !right_used.insert(pair.second).second) {
+			return -std::numeric_limits<double>::infinity();
+		}
+		auto it = std::find_if(pairs.begin(), pairs.end(), [&](const WeightedPair &p) {
+			return p.left == pair.first && p.right == pair.second;
+		});
+		if (it == pairs.end()) return -std::numeric_limits<double>::infinity();
+		result += it->weight;
+	}
+	return result;
+}
+
+double maximum_matching_weight(const std::vector<WeightedPair> &pairs, size_t left_num,
+                               size_t right_num) {
+	// best[mask] is the maximum weight of a matching of the processed left vertices using
+	// exactly the right vertices in mask
+	const size_t masks = size_t{1} << right_num;
+	const double none = -std::numeric_limits<double>::infinity();
+	std::vector<double> best(masks, none);
+	best[0] = 0;
+	for (size_t i = 0; i < left_num; i++) {
+		std::vector<double> next = best;
+		for (const auto &pair : pairs) {
+			if (pair.left != i) continue;
+			const size_t bit = size_t{1} << pair.right;
+			for (size_t mask = 0; mask < masks; mask++) {
+				if ((mask & bit) != 0 || best[mask] == none) continue;
+				next[mask | bit] = std::max(next[mask | bit], best[mask] + pair.weight);
+			}
+		}
+		best = next;
+	}
+	return *std::max_element(best.begin(), best.end());
+}